@@ -0,0 +1,138 @@
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ *  SampleCodec — storage formats for DelayLine samples.
+ *
+ *   • float   — stored as is
+ *   • int16_t — half the memory: full scale ±INT16_FULL_SCALE (+6 dB of
+ *     headroom over 0 dBFS, clipped beyond), quantisation floor ≈ −95 dBFS
+ *
+ *  Readers widen back to float with decode().
+ */
+struct SampleCodec
+{
+    static constexpr float INT16_FULL_SCALE = 2.f;
+
+    static float decode (float x)   noexcept { return x; }
+    static float decode (int16_t x) noexcept { return static_cast<float> (x) * (INT16_FULL_SCALE / 32768.f); }
+
+    static void encode (float x, float& out) noexcept { out = x; }
+
+    static void encode (float x, int16_t& out) noexcept
+    {
+        out = static_cast<int16_t> (juce::jlimit (-32768, 32767, juce::roundToInt (x * (32768.f / INT16_FULL_SCALE))));
+    }
+};
+
+/**
+ *  DelayLine — circular sample history shared by the tape, spring and shimmer.
+ *
+ *   • Power-of-two length: every index wraps with a single AND — no % and no
+ *     compare-and-reset in the sample loops
+ *   • Mirrored guard zone: the first GUARD frames are repeated past the end,
+ *     so an interpolation window is always contiguous and needs no wrap logic
+ *   • NumChannels samples per frame, interleaved (the stereo tape reads L and
+ *     R from one cache line; a comb bank keeps each instant of every comb together)
+ *
+ *  Indices are absolute sample counts — any int, masked on access:
+ *  frame (getWritePos() − d) is the frame pushed d pushes ago.
+ */
+template <typename T, int NumChannels = 1>
+class DelayLine
+{
+public:
+    static constexpr int NUM_CHANNELS = NumChannels;
+    static constexpr int GUARD        = 16; // widest interpolation window (16-tap sinc)
+
+    /** Allocates for reads up to maxDelaySamples behind the write position, cleared. */
+    void setMaximumDelay (int maxDelaySamples)
+    {
+        size = juce::nextPowerOfTwo (juce::jmax (maxDelaySamples + GUARD, 2 * GUARD));
+        mask = size - 1;
+        storage.assign (static_cast<size_t> ((size + GUARD) * NumChannels), T {});
+        writePos = 0;
+    }
+
+    void clear() noexcept
+    {
+        std::fill (storage.begin(), storage.end(), T {});
+        writePos = 0;
+    }
+
+    /** Capacity in frames (power of two). */
+    int getSize() const noexcept { return size; }
+
+    /** Bytes allocated for the samples (guard zone included). */
+    size_t getStorageBytes() const noexcept { return storage.size() * sizeof (T); }
+
+    /** Index the next push() writes to. */
+    int getWritePos() const noexcept { return writePos; }
+
+    // ── Write ─────────────────────────────────────────────────────────
+    /** Stores one frame of NumChannels samples and advances the write position. */
+    void push (const T* frame) noexcept
+    {
+        T* dest = storage.data() + writePos * NumChannels;
+        std::copy_n (frame, NumChannels, dest);
+
+        if (writePos < GUARD)
+            std::copy_n (frame, NumChannels, dest + size * NumChannels);
+
+        writePos = (writePos + 1) & mask;
+    }
+
+    void push (T sample) noexcept
+    {
+        static_assert (NumChannels == 1, "push a whole frame on multi-channel lines");
+        push (&sample);
+    }
+
+    // ── Read ──────────────────────────────────────────────────────────
+    /** Frame at an absolute index. */
+    const T* frame (int index) const noexcept
+    {
+        return storage.data() + (index & mask) * NumChannels;
+    }
+
+    /**
+     *  Interpolation window of Width frames for the point `delay` samples
+     *  before index pos: frames[k * NumChannels + c], k = 0 … Width − 1, oldest
+     *  first.  The read point lies at frac from k = (Width − 1) / 2:
+     *   • even Width — between the two middle frames, frac ∈ (0, 1]
+     *     (4-point kernels: k = 0 … 3 around k = 1, 2; linear: k = 0, 1)
+     *   • odd Width  — centred on the nearest frame, frac ∈ (−½, ½]
+     */
+    struct Tap
+    {
+        const T* frames;
+        float    frac;
+    };
+
+    template <int Width = 4>
+    Tap tap (int pos, float delay) const noexcept
+    {
+        static_assert (Width >= 2 && Width <= GUARD, "window wider than the guard zone");
+        jassert (delay >= 0.f);
+
+        if constexpr (Width % 2 == 0)
+        {
+            const int whole = static_cast<int> (delay);
+            return { frame (pos - whole - Width / 2), 1.f - (delay - static_cast<float> (whole)) };
+        }
+        else
+        {
+            const int nearest = static_cast<int> (delay + 0.5f);
+            return { frame (pos - nearest - (Width - 1) / 2), static_cast<float> (nearest) - delay };
+        }
+    }
+
+private:
+    std::vector<T> storage;   // (size + GUARD) frames
+    int size     = 0;
+    int mask     = 0;
+    int writePos = 0;
+};
@@ -0,0 +1,301 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+#include <array>
+#include <cmath>
+
+/**
+ *  HalfbandStage – one 2× half-band FIR stage on juce::dsp::SIMDRegister
+ *  frames (one lane per channel).  The prototype has 4·HalfTaps − 1 taps: the
+ *  centre tap (½) plus 2·HalfTaps non-zero odd-offset taps g[i].
+ *
+ *    up:    y[2n] = 2·Σ g[i]·x[n−i]        y[2n+1] = x[n − HalfTaps + 1]
+ *    down:  y[n]  = Σ g[i]·v[2(n−i)+1]  +  ½·v[2(n − HalfTaps + 1)]
+ */
+template <int HalfTaps>
+struct HalfbandStage
+{
+    using Vec = juce::dsp::SIMDRegister<float>;
+
+    static constexpr int   TAPS    = 2 * HalfTaps;
+    static constexpr float LATENCY = static_cast<float> (TAPS) - 1.5f; // up + down, input-rate samples
+
+    HalfbandStage()
+    {
+        const int centre = TAPS - 1;             // prototype length 2·TAPS − 1
+        float sum = 0.f;
+
+        for (int i = 0; i < TAPS; ++i)
+        {
+            const int   k  = 2 * i - centre;     // odd offset from the centre
+            const float pk = juce::MathConstants<float>::pi * static_cast<float> (k);
+            const float r  = static_cast<float> (k) / static_cast<float> (centre);
+            const float w  = besselI0 (KAISER_BETA * std::sqrt (1.f - r * r)) / besselI0 (KAISER_BETA);
+
+            g[(size_t) i] = std::sin (pk * 0.5f) / pk * w;
+            sum += g[(size_t) i];
+        }
+
+        for (auto& c : g)
+            c *= 0.5f / sum; // Σg = ½ → unity DC gain
+    }
+
+    void reset() noexcept
+    {
+        upHist  .fill (Vec::expand (0.f));
+        downOdd .fill (Vec::expand (0.f));
+        downEven.fill (Vec::expand (0.f));
+        upPos = downPos = 0;
+    }
+
+    void upsample (const Vec* in, Vec* out, int numIn) noexcept
+    {
+        for (int n = 0; n < numIn; ++n)
+        {
+            const Vec* h = push (upHist, upPos, in[n]); // h[−i] = x[n−i]
+
+            out[2 * n]     = dot (h) * 2.f;
+            out[2 * n + 1] = h[-(HalfTaps - 1)];
+
+            if (++upPos >= TAPS) upPos = 0;
+        }
+    }
+
+    void downsample (const Vec* in, Vec* out, int numOut) noexcept
+    {
+        for (int n = 0; n < numOut; ++n)
+        {
+            const Vec* even = push (downEven, downPos, in[2 * n]);
+            const Vec* odd  = push (downOdd,  downPos, in[2 * n + 1]);
+
+            out[n] = dot (odd) + even[-(HalfTaps - 1)] * 0.5f;
+
+            if (++downPos >= TAPS) downPos = 0;
+        }
+    }
+
+private:
+    static constexpr float KAISER_BETA = 8.f;
+
+    std::array<float, TAPS> g {};
+
+    // Mirrored histories: each sample is written at pos and pos + TAPS,
+    // so the last TAPS samples are contiguous, newest at pos + TAPS
+    using History = std::array<Vec, 2 * TAPS>;
+    History upHist, downOdd, downEven;
+    int upPos = 0, downPos = 0;
+
+    /** Store x, return a pointer to it (older samples at negative offsets). */
+    static const Vec* push (History& hist, int pos, Vec x) noexcept
+    {
+        hist[(size_t) pos]          = x;
+        hist[(size_t) (pos + TAPS)] = x;
+        return hist.data() + pos + TAPS;
+    }
+
+    static float besselI0 (float x) noexcept
+    {
+        float sum = 1.f, term = 1.f;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (x / (2.f * static_cast<float> (k))) * (x / (2.f * static_cast<float> (k)));
+            sum  += term;
+        }
+        return sum;
+    }
+
+    Vec dot (const Vec* newest) const noexcept
+    {
+        Vec acc = newest[0] * g[0];
+        for (int i = 1; i < TAPS; ++i)
+            acc += newest[-i] * g[(size_t) i];
+        return acc;
+    }
+};
+
+/**
+ *  HalfbandOversampler – 1×/2×/4× oversampling for a memoryless nonlinearity.
+ *
+ *  Only the stage that needs it is oversampled (tape saturation, output soft
+ *  clip) — the rest of the chain keeps running at the base rate.
+ *
+ *   • Cascade of polyphase half-band FIR stages (2× each)
+ *   • Half-band: every other tap is zero, the centre tap is ½ — each stage
+ *     only convolves the non-zero branch, the other branch is a pure delay
+ *   • Channels are processed together, one juce::dsp::SIMDRegister lane each
+ *   • Kaiser-windowed sinc (β = 8): flat to 0.4 × fs, ≥ 78 dB image rejection
+ *
+ *  The round trip adds getLatencySamples() of base-rate delay: the stages'
+ *  fractional delay is padded at the high rate to a whole base-rate sample,
+ *  so hosts can compensate it exactly.
+ */
+template <int NumChannels>
+class HalfbandOversampler
+{
+public:
+    static constexpr int MAX_FACTOR_LOG2 = 2;
+
+    /** Allocates for blocks of up to maxBlockSize base-rate samples. */
+    void prepare (int maxBlockSize)
+    {
+        maxBlock = maxBlockSize;
+        frames.assign (static_cast<size_t> (maxBlockSize * 7), Vec::expand (0.f));
+        for (auto& ch : upBuffers)
+            ch.assign (static_cast<size_t> (maxBlockSize << MAX_FACTOR_LOG2), 0.f);
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        outer.reset();
+        inner.reset();
+        padHist.fill (Vec::expand (0.f));
+        padPos = 0;
+    }
+
+    /** 0 = off, 1 = 2×, 2 = 4×.  Filter states restart when it changes. */
+    void setFactorLog2 (int newFactorLog2) noexcept
+    {
+        newFactorLog2 = juce::jlimit (0, MAX_FACTOR_LOG2, newFactorLog2);
+        if (newFactorLog2 != factorLog2)
+        {
+            factorLog2 = newFactorLog2;
+            reset();
+        }
+    }
+
+    int getFactorLog2() const noexcept { return factorLog2; }
+
+    /** Round-trip delay in base-rate samples (a whole number). */
+    float getLatencySamples() const noexcept
+    {
+        return static_cast<float> ((getStageLatencyUp() + getPadUp()) >> factorLog2);
+    }
+
+    /**
+     *  Upsample io, run fn on the oversampled channels, downsample back into io.
+     *  fn (float* const* up, int numUpSamples) works in place; sample j of the
+     *  oversampled block belongs to base-rate sample j >> getFactorLog2().
+     *  With oversampling off fn runs on io directly.
+     */
+    template <typename Fn>
+    void process (float* const* io, int numSamples, Fn&& fn) noexcept
+    {
+        jassert (numSamples <= maxBlock);
+
+        if (factorLog2 == 0)
+        {
+            fn (io, numSamples);
+            return;
+        }
+
+        // ── Base rate → frames (lane = channel) ───────────────────────
+        alignas (Vec::SIMDRegisterSize) float lanes[LANES] = {};
+        auto* base = frames.data();
+        auto* mid  = base + maxBlock;     // 2× (4× mode only)
+        auto* up   = base + maxBlock * 3; // oversampled
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int c = 0; c < NumChannels; ++c)
+                lanes[c] = io[c][i];
+            base[i] = Vec::fromRawArray (lanes);
+        }
+
+        // ── Up ────────────────────────────────────────────────────────
+        const int numUp = numSamples << factorLog2;
+        if (factorLog2 == 1)
+        {
+            outer.upsample (base, up, numSamples);
+        }
+        else
+        {
+            outer.upsample (base, mid, numSamples);
+            inner.upsample (mid,  up,  numSamples * 2);
+        }
+
+        // ── Nonlinearity at the high rate ─────────────────────────────
+        std::array<float*, NumChannels> upCh;
+        for (int c = 0; c < NumChannels; ++c)
+            upCh[(size_t) c] = upBuffers[(size_t) c].data();
+
+        for (int j = 0; j < numUp; ++j)
+        {
+            up[j].copyToRawArray (lanes);
+            for (int c = 0; c < NumChannels; ++c)
+                upCh[(size_t) c][j] = lanes[c];
+        }
+
+        fn (upCh.data(), numUp);
+
+        const int pad = getPadUp();
+        for (int j = 0; j < numUp; ++j)
+        {
+            for (int c = 0; c < NumChannels; ++c)
+                lanes[c] = upCh[(size_t) c][j];
+
+            // Pad to a whole base-rate sample of latency (pad < factor ≤ 4)
+            padHist[(size_t) padPos] = Vec::fromRawArray (lanes);
+            up[j]  = padHist[(size_t) ((padPos - pad) & 3)];
+            padPos = (padPos + 1) & 3;
+        }
+
+        // ── Down ──────────────────────────────────────────────────────
+        if (factorLog2 == 1)
+        {
+            outer.downsample (up, base, numSamples);
+        }
+        else
+        {
+            inner.downsample (up,  mid,  numSamples * 2);
+            outer.downsample (mid, base, numSamples);
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            base[i].copyToRawArray (lanes);
+            for (int c = 0; c < NumChannels; ++c)
+                io[c][i] = lanes[c];
+        }
+    }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int LANES = static_cast<int> (Vec::SIMDNumElements);
+    static_assert (NumChannels >= 1 && NumChannels <= LANES,
+                   "one SIMD register must hold every channel");
+
+    using OuterStage = HalfbandStage<16>; // 63-tap prototype, base ↔ 2×
+    using InnerStage = HalfbandStage<6>;  // 23-tap prototype, 2× ↔ 4× (wide transition band)
+
+    OuterStage outer;
+    InnerStage inner;
+
+    int factorLog2 = 0;
+    int maxBlock   = 0;
+
+    std::array<Vec, 4> padHist {}; // last high-rate frames, for the latency pad
+    int padPos = 0;
+
+    /** Delay of the half-band stages in high-rate samples (a whole number). */
+    int getStageLatencyUp() const noexcept
+    {
+        switch (factorLog2)
+        {
+            case 1:  return static_cast<int> (OuterStage::LATENCY * 2.f);
+            case 2:  return static_cast<int> (OuterStage::LATENCY * 4.f + InnerStage::LATENCY * 2.f);
+            default: return 0;
+        }
+    }
+
+    /** High-rate samples that round the stage delay up to a base-rate sample. */
+    int getPadUp() const noexcept
+    {
+        const int factor = 1 << factorLog2;
+        return (factor - getStageLatencyUp() % factor) % factor;
+    }
+
+    // base [0, M) · 2× [M, 3M) · oversampled [3M, 7M), M = maxBlock
+    std::vector<Vec> frames;
+    std::array<std::vector<float>, NumChannels> upBuffers;
+};
@@ -0,0 +1,236 @@
+#pragma once
+#include <JuceHeader.h>
+#include "DelayLine.h"
+#include <array>
+#include <cmath>
+
+/**
+ *  Fractional-delay readers for the tape heads, one lane per channel.
+ *
+ *  Each reader is a policy with
+ *   • WIDTH    — frames in its window (DelayLine::tap<WIDTH>)
+ *   • Window   — gather scratch: load() copies one channel of a tap into a lane
+ *                (float or compact int16 frames, widened to float)
+ *   • interpolate<NumLanes> (window) — the read value of every used lane
+ *
+ *  Quality / cost, cheapest first:
+ *   • LinearInterpolator      2 taps — live rigs, audible HF loss when modulated
+ *   • CatmullRomInterpolator  4 taps — the classic tape read (default)
+ *   • LagrangeInterpolator    5 taps — 4th-order, centred on the nearest frame
+ *   • SincInterpolator       16 taps — Kaiser-windowed sinc, polyphase table,
+ *                                      for offline / mastering renders
+ */
+namespace InterpolationDetail
+{
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int LANES = static_cast<int> (Vec::SIMDNumElements);
+
+    /** Window of WIDTH frames stored tap-major: y[k] holds tap k of every lane. */
+    template <int Width>
+    struct LaneWindow
+    {
+        alignas (Vec::SIMDRegisterSize) float y[Width][LANES] = {};
+        alignas (Vec::SIMDRegisterSize) float t[LANES] = {};
+
+        /** frames[k * stride + channel], k = 0 … Width − 1; frac as returned by tap(). */
+        template <typename Sample>
+        void load (int lane, const Sample* frames, int stride, int channel, float frac) noexcept
+        {
+            for (int k = 0; k < Width; ++k)
+                y[k][lane] = SampleCodec::decode (frames[k * stride + channel]);
+            t[lane] = frac;
+        }
+
+        Vec tap (int k) const noexcept { return Vec::fromRawArray (y[k]); }
+        Vec frac()      const noexcept { return Vec::fromRawArray (t); }
+    };
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+struct LinearInterpolator
+{
+    static constexpr int WIDTH = 2;
+    using Window = InterpolationDetail::LaneWindow<WIDTH>;
+    using Vec    = InterpolationDetail::Vec;
+
+    template <int NumLanes>
+    static Vec interpolate (const Window& w) noexcept
+    {
+        const Vec y0 = w.tap (0);
+        return y0 + (w.tap (1) - y0) * w.frac();
+    }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+struct CatmullRomInterpolator
+{
+    static constexpr int WIDTH = 4;
+    using Window = InterpolationDetail::LaneWindow<WIDTH>;
+    using Vec    = InterpolationDetail::Vec;
+
+    template <int NumLanes>
+    static Vec interpolate (const Window& w) noexcept
+    {
+        const Vec y0 = w.tap (0);
+        const Vec y1 = w.tap (1);
+        const Vec y2 = w.tap (2);
+        const Vec y3 = w.tap (3);
+        const Vec t  = w.frac();
+
+        const Vec a0 = y0 * -0.5f + y1 * 1.5f - y2 * 1.5f + y3 * 0.5f;
+        const Vec a1 = y0         - y1 * 2.5f + y2 * 2.0f - y3 * 0.5f;
+        const Vec a2 = y0 * -0.5f             + y2 * 0.5f;
+
+        return ((a0 * t + a1) * t + a2) * t + y1;
+    }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+/**
+ *  4th-order (5-point) Lagrange.  An odd window is centred on the frame nearest
+ *  the read point (frac ∈ (−½, ½] from the middle tap), where Lagrange
+ *  fractional delays have their smallest error.
+ */
+struct LagrangeInterpolator
+{
+    static constexpr int WIDTH = 5;
+    using Window = InterpolationDetail::LaneWindow<WIDTH>;
+    using Vec    = InterpolationDetail::Vec;
+
+    template <int NumLanes>
+    static Vec interpolate (const Window& w) noexcept
+    {
+        // Distances of the read point x from the taps at −2 … +2
+        const Vec x   = w.frac();
+        const Vec dm2 = x + Vec::expand (2.f);
+        const Vec dm1 = x + Vec::expand (1.f);
+        const Vec dp1 = x - Vec::expand (1.f);
+        const Vec dp2 = x - Vec::expand (2.f);
+
+        const Vec lo = dm2 * dm1; // (x + 2)(x + 1)
+        const Vec hi = dp1 * dp2; // (x − 1)(x − 2)
+
+        return w.tap (0) * (dm1 * x * hi * (1.f / 24.f))
+             + w.tap (1) * (dm2 * x * hi * (-1.f / 6.f))
+             + w.tap (2) * (lo * hi * 0.25f)
+             + w.tap (3) * (lo * x * dp2 * (-1.f / 6.f))
+             + w.tap (4) * (lo * x * dp1 * (1.f / 24.f));
+    }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+/**
+ *  16-tap Kaiser-windowed sinc from a polyphase table of PHASES + 1 rows,
+ *  linearly interpolated between adjacent phases.  Each row is normalised
+ *  to unity DC gain.  The table is fine enough that the phase lerp stays
+ *  well under the windowed kernel's own passband error (≈ −90 dB).
+ *
+ *  SIMD runs along the taps: a lane's window is contiguous, so the
+ *  coefficient lerp and the dot product take WIDTH / SIMDNumElements
+ *  register operations per channel.
+ *
+ *  The table is built on first use — call getTable() outside the audio
+ *  thread (TapeDelay::prepare() does).
+ */
+struct SincInterpolator
+{
+    static constexpr int WIDTH  = 16;
+    static constexpr int PHASES = 1024; // lerp between rows < −125 dB up to 18 kHz at 48 kHz
+    using Vec = InterpolationDetail::Vec;
+    static constexpr int LANES = InterpolationDetail::LANES;
+
+    static_assert (WIDTH % LANES == 0, "a row must be a whole number of registers");
+
+    struct Table
+    {
+        alignas (Vec::SIMDRegisterSize) std::array<float, (PHASES + 1) * WIDTH> coeffs;
+
+        Table()
+        {
+            constexpr double beta = 8.0;
+            const double     norm = 1.0 / bessel0 (beta);
+            constexpr int    centre = (WIDTH - 1) / 2; // read point lies between centre and centre + 1
+
+            for (int p = 0; p <= PHASES; ++p)
+            {
+                float* row = coeffs.data() + p * WIDTH;
+                double sum = 0.0;
+
+                for (int k = 0; k < WIDTH; ++k)
+                {
+                    const double x = k - centre - static_cast<double> (p) / PHASES;
+                    const double r = x / (WIDTH / 2);
+                    const double window = std::abs (r) < 1.0 ? bessel0 (beta * std::sqrt (1.0 - r * r)) * norm : 0.0;
+                    const double sinc   = x == 0.0 ? 1.0 : std::sin (juce::MathConstants<double>::pi * x)
+                                                           / (juce::MathConstants<double>::pi * x);
+                    row[k] = static_cast<float> (sinc * window);
+                    sum   += row[k];
+                }
+
+                for (int k = 0; k < WIDTH; ++k)
+                    row[k] = static_cast<float> (row[k] / sum);
+            }
+        }
+
+        static double bessel0 (double x) noexcept
+        {
+            double sum = 1.0, term = 1.0;
+            for (int k = 1; k < 32; ++k)
+            {
+                term *= (x / (2.0 * k)) * (x / (2.0 * k));
+                sum  += term;
+            }
+            return sum;
+        }
+    };
+
+    static const Table& getTable()
+    {
+        static const Table table;
+        return table;
+    }
+
+    /** Window stored lane-major: each lane's taps are contiguous. */
+    struct Window
+    {
+        alignas (Vec::SIMDRegisterSize) float y[LANES][WIDTH] = {};
+        const float* row[LANES] = {};
+        float        f[LANES]   = {};
+
+        template <typename Sample>
+        void load (int lane, const Sample* frames, int stride, int channel, float frac) noexcept
+        {
+            for (int k = 0; k < WIDTH; ++k)
+                y[lane][k] = SampleCodec::decode (frames[k * stride + channel]);
+
+            const float pos   = frac * static_cast<float> (PHASES);
+            const int   phase = juce::jmin (PHASES - 1, static_cast<int> (pos));
+            row[lane] = getTable().coeffs.data() + phase * WIDTH;
+            f[lane]   = pos - static_cast<float> (phase);
+        }
+    };
+
+    template <int NumLanes>
+    static Vec interpolate (const Window& w) noexcept
+    {
+        alignas (Vec::SIMDRegisterSize) float out[LANES] = {};
+
+        for (int lane = 0; lane < NumLanes; ++lane)
+        {
+            const float* r0 = w.row[lane];
+            const float* r1 = r0 + WIDTH;
+            const Vec    f  = Vec::expand (w.f[lane]);
+
+            Vec acc = Vec::expand (0.f);
+            for (int k = 0; k < WIDTH; k += LANES)
+            {
+                const Vec c0 = Vec::fromRawArray (r0 + k);
+                const Vec c1 = Vec::fromRawArray (r1 + k);
+                acc += (c0 + (c1 - c0) * f) * Vec::fromRawArray (w.y[lane] + k);
+            }
+            out[lane] = acc.sum();
+        }
+
+        return Vec::fromRawArray (out);
+    }
+};
@@ -0,0 +1,214 @@
+#pragma once
+#include <JuceHeader.h>
+#include "HalfbandOversampler.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+/**
+ *  LoopResampler – runs a feedback loop at ½ or ¼ of the host rate.
+ *
+ *  The loop's input is decimated and its output interpolated back through
+ *  the half-band stages of HalfbandOversampler, one juce::dsp::SIMDRegister
+ *  lane per channel.  Blocks need not be multiples of the factor:
+ *   • decimate()    – a host block → the loop samples it completes; host
+ *                     samples short of a full period wait for the next block
+ *   • interpolate() – those loop samples → exactly as many host samples as
+ *                     went in, from a FIFO primed with at least getFactor() − 1
+ *                     samples (padded so the round trip is whole loop samples)
+ *
+ *  The round trip is getLatency() whole loop samples.  A delay loop hides it
+ *  by reading that much early and passing its feedback through
+ *  delayFeedback(): echoes keep their timing, the loop keeps its period.
+ */
+template <int NumChannels>
+class LoopResampler
+{
+public:
+    static constexpr int MAX_FACTOR = 4;
+
+    /** Largest factor (1, 2 or 4) that keeps the loop at minRate or above. */
+    static int chooseFactor (double sampleRate, double minRate) noexcept
+    {
+        int f = 1;
+        while (f < MAX_FACTOR && sampleRate / (2 * f) >= minRate)
+            f *= 2;
+        return f;
+    }
+
+    /** Allocates for blocks of up to maxBlockSize host samples. */
+    void prepare (int newFactor, int maxBlockSize)
+    {
+        jassert (newFactor == 1 || newFactor == 2 || newFactor == MAX_FACTOR);
+        factor   = newFactor;
+        maxBlock = maxBlockSize;
+
+        // Host frames (+ pending), the 2× stage, loop frames, output FIFO
+        hostFrames.assign (static_cast<size_t> (maxBlock + MAX_FACTOR), Vec::expand (0.f));
+        midFrames .assign (static_cast<size_t> (maxBlock + MAX_FACTOR), Vec::expand (0.f));
+        loopFrames.assign (static_cast<size_t> (maxBlock + MAX_FACTOR), Vec::expand (0.f));
+        outFifo   .assign (static_cast<size_t> (maxBlock + 3 * MAX_FACTOR), Vec::expand (0.f));
+
+        // Host-sample round trip: each stage's down + up delay, plus a FIFO
+        // of factor − 1 frames padded up to a whole number of loop samples
+        float filterLatency = 0.f;
+        if (factor >= 2)          filterLatency += OuterStage::LATENCY * (float) factor;
+        if (factor == MAX_FACTOR) filterLatency += InnerStage::LATENCY * 2.f;
+
+        const int hostLatency = juce::roundToInt (filterLatency) + factor - 1;
+        latency   = (hostLatency + factor - 1) / factor;
+        fifoDepth = factor == 1 ? 0 : latency * factor - juce::roundToInt (filterLatency);
+
+        feedbackRing.assign (static_cast<size_t> (juce::jmax (1, latency)), Vec::expand (0.f));
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        outer.reset();
+        inner.reset();
+        std::fill (outFifo.begin(), outFifo.end(), Vec::expand (0.f));
+        std::fill (feedbackRing.begin(), feedbackRing.end(), Vec::expand (0.f));
+        numPending = 0;
+        numQueued  = fifoDepth;
+        feedbackPos = 0;
+    }
+
+    int getFactor()  const noexcept { return factor; }
+
+    /** Decimate + interpolate delay, in loop samples. */
+    int getLatency() const noexcept { return latency; }
+
+    /** Loop samples produced by a numSamples host block: ≤ numSamples / factor + 1. */
+    int decimate (const float* const* in, int numSamples, float* const* out) noexcept
+    {
+        jassert (numSamples <= maxBlock);
+
+        if (factor == 1)
+        {
+            for (int c = 0; c < NumChannels; ++c)
+                std::copy_n (in[c], numSamples, out[c]);
+            return numSamples;
+        }
+
+        // Pending frames are already at the front
+        auto* host = hostFrames.data();
+        pack (in, host + numPending, numSamples);
+
+        const int total   = numPending + numSamples;
+        const int numLoop = total / factor;
+        const int used    = numLoop * factor;
+
+        if (factor == MAX_FACTOR)
+        {
+            inner.downsample (host, midFrames.data(), numLoop * 2);
+            outer.downsample (midFrames.data(), loopFrames.data(), numLoop);
+        }
+        else
+        {
+            outer.downsample (host, loopFrames.data(), numLoop);
+        }
+
+        numPending = total - used;
+        std::copy_n (host + used, numPending, host);
+
+        unpack (loopFrames.data(), out, numLoop);
+        return numLoop;
+    }
+
+    /** numLoop: decimate()'s result for the same numSamples host block. */
+    void interpolate (const float* const* in, int numLoop, float* const* out, int numSamples) noexcept
+    {
+        if (factor == 1)
+        {
+            for (int c = 0; c < NumChannels; ++c)
+                std::copy_n (in[c], numSamples, out[c]);
+            return;
+        }
+
+        pack (in, loopFrames.data(), numLoop);
+
+        auto* queue = outFifo.data() + numQueued;
+        if (factor == MAX_FACTOR)
+        {
+            outer.upsample (loopFrames.data(), midFrames.data(), numLoop);
+            inner.upsample (midFrames.data(), queue, numLoop * 2);
+        }
+        else
+        {
+            outer.upsample (loopFrames.data(), queue, numLoop);
+        }
+
+        numQueued += numLoop * factor;
+        jassert (numQueued >= numSamples);
+
+        unpack (outFifo.data(), out, numSamples);
+        numQueued -= numSamples;
+        std::copy_n (outFifo.data() + numSamples, numQueued, outFifo.data());
+    }
+
+    /** getLatency() loop samples of delay, for the loop's feedback path. */
+    void delayFeedback (const float* const* in, float* const* out, int numLoop) noexcept
+    {
+        alignas (Vec::SIMDRegisterSize) float lanes[LANES] = {};
+        const int ringSize = static_cast<int> (feedbackRing.size());
+
+        for (int i = 0; i < numLoop; ++i)
+        {
+            for (int c = 0; c < NumChannels; ++c)
+                lanes[c] = in[c][i];
+
+            auto& slot = feedbackRing[(size_t) feedbackPos];
+            const Vec delayed = slot;
+            slot = Vec::fromRawArray (lanes);
+            if (++feedbackPos == ringSize) feedbackPos = 0;
+
+            delayed.copyToRawArray (lanes);
+            for (int c = 0; c < NumChannels; ++c)
+                out[c][i] = latency > 0 ? lanes[c] : in[c][i];
+        }
+    }
+
+private:
+    using Vec        = juce::dsp::SIMDRegister<float>;
+    using OuterStage = HalfbandStage<16>;   // loop rate ↔ 2×
+    using InnerStage = HalfbandStage<6>;    // 2× ↔ 4×
+    static constexpr int LANES = static_cast<int> (Vec::SIMDNumElements);
+    static_assert (NumChannels >= 1 && NumChannels <= LANES,
+                   "one SIMD register must hold every channel");
+
+    int factor    = 1;
+    int maxBlock  = 0;
+    int latency   = 0;     // loop samples
+    int fifoDepth = 0;     // interpolated frames primed by reset()
+
+    OuterStage outer;
+    InnerStage inner;
+
+    std::vector<Vec> hostFrames, midFrames, loopFrames, outFifo, feedbackRing;
+    int numPending  = 0;   // host frames waiting for a full period
+    int numQueued   = 0;   // interpolated frames not yet handed out
+    int feedbackPos = 0;
+
+    static void pack (const float* const* in, Vec* frames, int numSamples) noexcept
+    {
+        alignas (Vec::SIMDRegisterSize) float lanes[LANES] = {};
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int c = 0; c < NumChannels; ++c)
+                lanes[c] = in[c][i];
+            frames[i] = Vec::fromRawArray (lanes);
+        }
+    }
+
+    static void unpack (const Vec* frames, float* const* out, int numSamples) noexcept
+    {
+        alignas (Vec::SIMDRegisterSize) float lanes[LANES];
+        for (int i = 0; i < numSamples; ++i)
+        {
+            frames[i].copyToRawArray (lanes);
+            for (int c = 0; c < NumChannels; ++c)
+                out[c][i] = lanes[c];
+        }
+    }
+};
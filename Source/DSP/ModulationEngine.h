@@ -0,0 +1,192 @@
+#pragma once
+#include <JuceHeader.h>
+#include "RandomSeed.h"
+#include <array>
+#include <cmath>
+
+/**
+ *  QuadratureOscillator — sine/cosine pair advanced by a fixed rotation.
+ *
+ *  One complex multiply per step instead of a std::sin; a first-order
+ *  Newton correction after each step keeps the amplitude at 1 so rounding
+ *  never accumulates.
+ */
+class QuadratureOscillator
+{
+public:
+    /** @param phase  starting phase in cycles (0..1) */
+    void setPhase (float phase) noexcept
+    {
+        const double w = juce::MathConstants<double>::twoPi * phase;
+        c = static_cast<float> (std::cos (w));
+        s = static_cast<float> (std::sin (w));
+    }
+
+    /** Phase advance per advance() call, in cycles. */
+    void setIncrement (double cyclesPerStep) noexcept
+    {
+        const double w = juce::MathConstants<double>::twoPi * cyclesPerStep;
+        rotC = static_cast<float> (std::cos (w));
+        rotS = static_cast<float> (std::sin (w));
+    }
+
+    float sine() const noexcept { return s; }
+
+    void advance() noexcept
+    {
+        const float nc = c * rotC - s * rotS;
+        const float ns = c * rotS + s * rotC;
+        const float g  = 1.5f - 0.5f * (nc * nc + ns * ns);
+        c = nc * g;
+        s = ns * g;
+    }
+
+private:
+    float c = 1.f, s = 0.f;
+    float rotC = 1.f, rotS = 0.f;
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+/**
+ *  ModulationEngine — tape transport speed deviation, per channel.
+ *
+ *   • Wow (0.4 Hz, per-channel phase), flutter (8 Hz + 13.7 Hz) and motor
+ *     drift (0.05 Hz) run on quadrature oscillators at control rate only
+ *   • Between control points the LFO sum is linearly interpolated —
+ *     at 16 samples the chord error on the fastest LFO is < 10⁻⁴ of its depth
+ *   • Organic random flutter (xorshift → ~5 Hz LP) stays per sample: it is
+ *     cheap and its spectrum depends on the rate it is filtered at
+ *
+ *  The owner decides where control segments start (beginSegment()) so it can
+ *  update its own coefficients on the same grid.
+ */
+template <int NumChannels>
+class ModulationEngine
+{
+public:
+    static constexpr int DEFAULT_CONTROL_INTERVAL = 16;
+
+    /** @param seed  RandomSeed for the random flutter (0 = historical flutter). */
+    void prepare (double sampleRate, const std::array<float, NumChannels>& wowSeedPhases,
+                  int controlInterval, uint32_t seed = 0)
+    {
+        sr         = sampleRate;
+        wowPhases  = wowSeedPhases;
+        randomSeed = seed;
+
+        setControlInterval (controlInterval);
+        reset();
+    }
+
+    /** Back to the prepared starting point: LFO phases and random flutter state. */
+    void reset() noexcept
+    {
+        for (int c = 0; c < NumChannels; ++c)
+            wow[(size_t) c].setPhase (wowPhases[(size_t) c]);
+        flutter .setPhase (0.0f);
+        flutter2.setPhase (0.37f);
+        drift   .setPhase (0.0f);
+
+        randState     = RandomSeed::derive (SEED_BASE, randomSeed);
+        randomFlutter = 0.f;
+        lfo.fill (0.f);
+        lfoStep.fill (0.f);
+        driftValue = driftStep = 0.f;
+    }
+
+    /** Oscillators step once per control segment of this many samples. */
+    void setControlInterval (int samples) noexcept
+    {
+        interval = juce::jmax (1, samples);
+
+        const double steps = static_cast<double> (interval) / sr;
+        for (auto& osc : wow)
+            osc.setIncrement (0.4 * steps);
+        flutter .setIncrement (8.0  * steps);
+        flutter2.setIncrement (13.7 * steps);
+        drift   .setIncrement (0.05 * steps);
+    }
+
+    int getControlInterval() const noexcept { return interval; }
+
+    /** Start a control segment: next() ramps to the LFO values one interval ahead. */
+    void beginSegment() noexcept
+    {
+        const auto from      = periodic();
+        const float fromDrift = drift.sine() * DRIFT_DEPTH;
+
+        for (auto& osc : wow) osc.advance();
+        flutter .advance();
+        flutter2.advance();
+        drift   .advance();
+
+        const auto to      = periodic();
+        const float toDrift = drift.sine() * DRIFT_DEPTH;
+        const float inv     = 1.f / static_cast<float> (interval);
+
+        for (int c = 0; c < NumChannels; ++c)
+        {
+            lfo    [(size_t) c] = from[(size_t) c];
+            lfoStep[(size_t) c] = (to[(size_t) c] - from[(size_t) c]) * inv;
+        }
+
+        driftValue = fromDrift;
+        driftStep  = (toDrift - fromDrift) * inv;
+    }
+
+    /** Speed deviation of the next sample (fraction of nominal), per channel. */
+    std::array<float, NumChannels> next (float wowFlutterAmt) noexcept
+    {
+        // xorshift32 noise → LP-filtered to ~5 Hz → organic random flutter
+        randState ^= randState << 13;
+        randState ^= randState >> 17;
+        randState ^= randState << 5;
+        const float rNoise = static_cast<float> (static_cast<int32_t> (randState)) * 4.656e-10f;
+        randomFlutter += 0.000713f * (rNoise - randomFlutter); // LP ≈ 5 Hz at 44100
+
+        std::array<float, NumChannels> totalMod;
+        for (int c = 0; c < NumChannels; ++c)
+        {
+            totalMod[(size_t) c] = (lfo[(size_t) c] + randomFlutter * 0.025f) * wowFlutterAmt
+                                 + driftValue;
+            lfo[(size_t) c] += lfoStep[(size_t) c];
+        }
+        driftValue += driftStep;
+
+        return totalMod;
+    }
+
+private:
+    // 0.05 Hz motor drift, ±0.15% pitch — always on, independent of wow/flutter
+    static constexpr float DRIFT_DEPTH = 0.0015f;
+
+    static constexpr uint32_t SEED_BASE = 2463534242u;
+
+    double sr       = 44100.0;
+    int    interval = DEFAULT_CONTROL_INTERVAL;
+
+    std::array<QuadratureOscillator, NumChannels> wow;
+    std::array<float, NumChannels> wowPhases {}; // prepare()'s starting phases
+    QuadratureOscillator flutter, flutter2, drift;
+
+    // Interpolated control-rate values
+    std::array<float, NumChannels> lfo {}, lfoStep {};
+    float driftValue = 0.f, driftStep = 0.f;
+
+    // Organic flutter noise
+    uint32_t randState     = SEED_BASE;
+    uint32_t randomSeed    = 0;
+    float    randomFlutter = 0.f;
+
+    /** Periodic wow + flutter at the oscillators' current phase. */
+    std::array<float, NumChannels> periodic() const noexcept
+    {
+        const float flt = flutter.sine() * 0.0009f   // 8 Hz flutter
+                        + flutter2.sine() * 0.0002f; // 13.7 Hz flutter
+
+        std::array<float, NumChannels> p;
+        for (int c = 0; c < NumChannels; ++c)
+            p[(size_t) c] = wow[(size_t) c].sine() * 0.0042f + flt; // 0.4 Hz wow
+        return p;
+    }
+};
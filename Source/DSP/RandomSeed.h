@@ -0,0 +1,34 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cstdint>
+
+/**
+ *  RandomSeed — starting states for the xorshift32 generators.
+ *
+ *  Every generator keeps its own base constant; the user seed is scrambled
+ *  (murmur3 finaliser) and XORed in, so
+ *   • seed 0 leaves every base untouched — the historical sound
+ *   • any other seed moves all generators together, each on its own stream
+ *
+ *  Generators restart from their seeded state on prepare() and reset(), so a
+ *  render depends only on its input, its parameters and the seed.
+ */
+struct RandomSeed
+{
+    static constexpr uint32_t scramble (uint32_t seed) noexcept
+    {
+        seed ^= seed >> 16;
+        seed *= 0x85EBCA6Bu;
+        seed ^= seed >> 13;
+        seed *= 0xC2B2AE35u;
+        seed ^= seed >> 16;
+        return seed;
+    }
+
+    /** Starting state for a generator with the given base; never 0 (xorshift fixed point). */
+    static constexpr uint32_t derive (uint32_t base, uint32_t seed) noexcept
+    {
+        const uint32_t state = base ^ scramble (seed);
+        return state != 0u ? state : base;
+    }
+};
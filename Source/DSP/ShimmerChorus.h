@@ -1,20 +1,32 @@
 #pragma once
 #include <JuceHeader.h>
+#include "SilenceDetector.h"
+#include "DelayLine.h"
 #include <array>
 #include <cmath>
 
 /**
- *  ShimmerChorus — Granular pitch shifter (+1 octave) for shimmer reverb.
+ *  ShimmerChorus — Granular pitch shifter (+1 octave by default, up to
+ *  MAX_VOICES intervals) for shimmer reverb.
  *
- *  Algorithm: two overlapping grains, each reading the delay buffer at 2×
- *  speed (= +1 octave), windowed with Hanning to avoid clicks at crossfades.
+ *  Algorithm: each voice is two overlapping grains reading the delay buffer
+ *  at its pitch ratio (2× speed = +1 octave), windowed with Hanning to avoid
+ *  clicks at crossfades.
  *
- *  Two grains are offset by half a grain cycle so their windows complement
- *  each other — when one fades in the other fades out, giving a continuous
- *  output with no silent gaps.
+ *  A voice's two grains are offset by half a grain cycle so their windows
+ *  complement each other — when one fades in the other fades out, giving a
+ *  continuous output with no silent gaps.
  *
  *  This is the same core algorithm as Valhalla's pitch-shifted reverbs.
  *
+ *  Every grain lasts GRAIN samples and reads the one shared buffer: a
+ *  voice only changes how far its grains travel behind the write head
+ *  (GRAIN · |ratio − 1|, towards the head going up, away from it going
+ *  down).  Grain windows, read positions and interpolation run one grain
+ *  per juce::dsp::SIMDRegister lane, so a voice costs two lanes and no
+ *  memory.  Read heads are kept as distances behind the write head, so
+ *  positions stay exact however long the plugin runs.
+ *
  *  Usage inside shimmer reverb:
  *    // Each sample:
  *    revL = spring.process(dry + shimmerFeedback);
@@ -25,27 +37,72 @@
 class ShimmerChorus
 {
 public:
-    static constexpr int GRAIN = 4096;  // ~93 ms at 44.1 kHz — smooth crossfades
-    static constexpr int BUF   = GRAIN * 4; // circular buffer, must be > 3×GRAIN
+    static constexpr int   GRAIN         = 4096;  // ~93 ms at 44.1 kHz — smooth crossfades
+    static constexpr int   BUF           = GRAIN * 4; // circular buffer, must be > 3×GRAIN
+    static constexpr int   MAX_VOICES    = 4;
+    static constexpr float MAX_SEMITONES = 24.f;  // grains travel ≤ 3×GRAIN
+
+    ShimmerChorus()
+    {
+        const float octave = 12.f;
+        setVoices (&octave, 1);
+    }
 
     void prepare (double /*sampleRate*/)
     {
+        buf.setMaximumDelay (BUF - DelayLine<float>::GUARD);
         reset();
     }
 
     void reset()
     {
-        buf.fill (0.f);
-        wPos = 0;
+        buf.clear();
+        silence.setRequiredRun (BUF);
+        silence.markSilent();
 
-        // Grain 2 starts halfway through its cycle so windows complement grain 1
-        r1 = -(float) GRAIN;
-        r2 = -(float) GRAIN * 0.5f;
+        // First grains start their cycle; second grains run half a cycle ahead
+        grainPhase = 0.f;
+    }
+
+    /** Intervals in semitones (±MAX_SEMITONES, up to MAX_VOICES), each at 1/√n. */
+    void setVoices (const float* semitones, int numVoices) noexcept
+    {
+        numVoices = juce::jlimit (0, MAX_VOICES, numVoices);
+        numGrains    = 2 * numVoices;
+        numRegisters = (numGrains + LANES - 1) / LANES;
+
+        // Lanes 2v, 2v + 1: voice v's grains; unused lanes read at gain 0
+        alignas (Vec::SIMDRegisterSize) float start[GRAINS] = {}, travel[GRAINS] = {},
+                                              gain[GRAINS]  = {}, second[GRAINS] = {};
+        const float voiceGain = numVoices > 0 ? 1.f / std::sqrt (static_cast<float> (numVoices)) : 0.f;
+
+        for (int v = 0; v < numVoices; ++v)
+        {
+            const float st    = juce::jlimit (-MAX_SEMITONES, MAX_SEMITONES, semitones[v]);
+            const float ratio = std::pow (2.f, st / 12.f);
+
+            // Distance behind the head at phase p: start + travel · p
+            for (int g = 2 * v; g < 2 * v + 2; ++g)
+            {
+                start[g]  = juce::jmax (0.f, ratio - 1.f) * static_cast<float> (GRAIN);
+                travel[g] = (1.f - ratio) * static_cast<float> (GRAIN);
+                gain[g]   = voiceGain;
+            }
+            second[2 * v + 1] = 1.f;
+        }
+
+        for (int r = 0; r < REGISTERS; ++r)
+        {
+            grainStart [(size_t) r] = Vec::fromRawArray (start  + r * LANES);
+            grainTravel[(size_t) r] = Vec::fromRawArray (travel + r * LANES);
+            grainGain  [(size_t) r] = Vec::fromRawArray (gain   + r * LANES);
+            isSecond   [(size_t) r] = Vec::fromRawArray (second + r * LANES);
+        }
     }
 
     /**
      *  Process one sample.
-     *  Returns the pitch-shifted (+1 octave) version of x, scaled by amount.
+     *  Returns the pitch-shifted version of x, scaled by amount.
      */
     float process (float x, float amount) noexcept
     {
@@ -53,60 +110,84 @@ public:
             return 0.f;
 
         // ── Write to circular buffer ──────────────────────────────────
-        buf[wPos & (BUF - 1)] = x;
-
-        // ── Compute Hanning window for each grain ─────────────────────
-        // phase = (r - (wPos - GRAIN)) / GRAIN  →  0..1 as r goes (wPos-GRAIN)..wPos
-        const float phase1 = juce::jlimit (0.f, 1.f,
-            (r1 - static_cast<float> (wPos) + static_cast<float> (GRAIN))
-            / static_cast<float> (GRAIN));
-
-        const float phase2 = juce::jlimit (0.f, 1.f,
-            (r2 - static_cast<float> (wPos) + static_cast<float> (GRAIN))
-            / static_cast<float> (GRAIN));
-
-        const float w1 = 0.5f - 0.5f * std::cos (phase1 * juce::MathConstants<float>::twoPi);
-        const float w2 = 0.5f - 0.5f * std::cos (phase2 * juce::MathConstants<float>::twoPi);
-
-        // ── Read both grains with linear interpolation ────────────────
-        const float s1 = readLinear (r1);
-        const float s2 = readLinear (r2);
-
-        const float out = s1 * w1 + s2 * w2;
-
-        // ── Advance read pointers at 2× write speed (= +1 octave) ─────
-        r1 += 2.f;
-        r2 += 2.f;
-        ++wPos;
-
-        // ── Reset grains once they have caught up with the write head ──
-        // (phase = 1  ↔  r == wPos)
-        if (r1 >= static_cast<float> (wPos))
-            r1 = static_cast<float> (wPos) - static_cast<float> (GRAIN);
-
-        if (r2 >= static_cast<float> (wPos))
-            r2 = static_cast<float> (wPos) - static_cast<float> (GRAIN);
-
-        return out * amount;
+        const int wPos = buf.getWritePos();
+        buf.push (x);
+        silence.push (x);
+
+        // ── Grain phases 0..1: first grains at p, second at p + ½ ────
+        const float p1 = grainPhase;
+        const float p2 = p1 < 0.5f ? p1 + 0.5f : p1 - 0.5f;
+        const Vec   phase1 = Vec::expand (p1);
+        const Vec   phaseStep = Vec::expand (p2 - p1);
+
+        Vec out = Vec::expand (0.f);
+        for (int r = 0; r < numRegisters; ++r)
+        {
+            const Vec phase = phase1 + isSecond[(size_t) r] * phaseStep;
+
+            // ── Hanning window sin²(π·p) = cos²(π·(p − ½)) ────────────
+            const Vec c = hannRoot (phase);
+            const Vec w = c * c * grainGain[(size_t) r];
+
+            // ── Read every grain with linear interpolation ────────────
+            alignas (Vec::SIMDRegisterSize) float delay[LANES], s1[LANES] = {}, s2[LANES] = {}, frac[LANES] = {};
+            (grainStart[(size_t) r] + grainTravel[(size_t) r] * phase).copyToRawArray (delay);
+
+            // Lanes past the last voice stay at 0
+            const int numLanes = juce::jmin (LANES, numGrains - r * LANES);
+            for (int l = 0; l < numLanes; ++l)
+            {
+                const auto tap = buf.tap (wPos, delay[l]);
+                s1[l]   = tap.frames[1];
+                s2[l]   = tap.frames[2];
+                frac[l] = tap.frac;
+            }
+
+            const Vec a = Vec::fromRawArray (s1);
+            out = out + (a + (Vec::fromRawArray (s2) - a) * Vec::fromRawArray (frac)) * w;
+        }
+
+        // ── Grains restart once a cycle is over (phase = 1 ↔ 0) ───────
+        grainPhase += 1.f / static_cast<float> (GRAIN);
+        if (grainPhase >= 1.f) grainPhase = 0.f;
+
+        return out.sum() * amount;
     }
 
-private:
-    std::array<float, BUF> buf = {};
-    int   wPos = 0;
-    float r1   = 0.f, r2 = 0.f;
-
-    /** Linear-interpolated read from the circular buffer. */
-    float readLinear (float pos) const noexcept
+    /** In-place block version of process(); amount is indexed per sample (array or constant accessor). */
+    template <typename Amount>
+    void processBlock (float* io, Amount amount, int numSamples) noexcept
     {
-        // Wrap into buffer range
-        float p = pos;
-        while (p < 0.f)        p += static_cast<float> (BUF);
-        while (p >= static_cast<float> (BUF)) p -= static_cast<float> (BUF);
+        for (int i = 0; i < numSamples; ++i)
+            io[i] = process (io[i], amount[i]);
+    }
 
-        const int   i0   = static_cast<int> (p) & (BUF - 1);
-        const int   i1   = (i0 + 1) & (BUF - 1);
-        const float frac = p - std::floor (p);
+    /** True once the whole grain buffer holds near-silence (nothing left to shift). */
+    bool isSilent() const noexcept { return silence.isSilent(); }
 
-        return buf[i0] * (1.f - frac) + buf[i1] * frac;
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int LANES     = static_cast<int> (Vec::SIMDNumElements);
+    static constexpr int GRAINS    = 2 * MAX_VOICES;
+    static constexpr int REGISTERS = GRAINS / LANES;
+    static_assert (GRAINS % LANES == 0, "the grains must fill whole registers");
+
+    DelayLine<float> buf;
+    SilenceDetector  silence;          // samples written below threshold
+    float grainPhase = 0.f;            // first grains' cycle position, 0..1
+
+    // Per-lane grain constants (setVoices)
+    std::array<Vec, REGISTERS> grainStart, grainTravel, grainGain, isSecond;
+    int numGrains    = 0;              // lanes holding active voices
+    int numRegisters = 0;              // registers holding them
+
+    /** cos (π·(p − ½)) for p ∈ [0, 1], |error| < 1e-6 (Taylor to x¹⁰). */
+    static Vec hannRoot (Vec p) noexcept
+    {
+        const Vec x  = (p - Vec::expand (0.5f)) * Vec::expand (juce::MathConstants<float>::pi);
+        const Vec x2 = x * x;
+        return Vec::expand (1.f) + x2 * (Vec::expand (-1.f / 2.f) + x2 * (Vec::expand (1.f / 24.f)
+                     + x2 * (Vec::expand (-1.f / 720.f) + x2 * (Vec::expand (1.f / 40320.f)
+                     + x2 * Vec::expand (-1.f / 3628800.f)))));
     }
 };
@@ -0,0 +1,37 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+
+/**
+ *  SilenceDetector — run-length counter of consecutive near-silent samples.
+ *
+ *  A DSP object feeds it whatever it stores (or emits) and declares itself
+ *  silent once a whole buffer's worth of samples stayed below THRESHOLD,
+ *  i.e. no audible energy can still be recirculating.
+ */
+class SilenceDetector
+{
+public:
+    static constexpr float THRESHOLD = 1.0e-5f; // −100 dBFS
+
+    /** Samples that must stay below THRESHOLD before isSilent(). */
+    void setRequiredRun (int numSamples) noexcept
+    {
+        required = juce::jmax (1, numSamples);
+        run = juce::jmin (run, required);
+    }
+
+    /** Start from a known-silent state (cleared buffers). */
+    void markSilent() noexcept { run = required; }
+
+    void push (float x) noexcept
+    {
+        run = (std::abs (x) <= THRESHOLD) ? juce::jmin (run + 1, required) : 0;
+    }
+
+    bool isSilent() const noexcept { return run >= required; }
+
+private:
+    int required = 1;
+    int run      = 0;
+};
@@ -0,0 +1,487 @@
+#pragma once
+#include <JuceHeader.h>
+#include "SilenceDetector.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ *  SpectralShimmer – phase-vocoder pitch shifter for shimmer reverb, the
+ *  alternative to ShimmerChorus's two-grain shifter.
+ *
+ *   • Hann-windowed FFT frames (2048 at 44.1 / 48 kHz, longer at higher
+ *     rates), hop = frame / 4, overlap-add resynthesis
+ *   • Per bin: true frequency from the phase advance between frames; each
+ *     voice moves the bin to round (k · ratio) and accumulates its phase at
+ *     ratio × that frequency
+ *   • Up to MAX_VOICES intervals (any number of semitones) share one
+ *     analysis and one inverse FFT — a voice only adds a pass over the bins
+ *
+ *  Frames run on a worker thread.  The frame ending with hop q is heard from
+ *  the start of hop q + D, D = 1 + ⌈host block / hop⌉ (at least 2): it is
+ *  never due in the callback that posted it, the worker has at least one
+ *  hop (~11 ms at 48 kHz) to deliver it, and the latency is fixed at
+ *  getLatencySamples() (frame + (D − 1) hops).  Each job carries its own
+ *  copy of the frame.  A late worker costs hops rather than stalling the
+ *  audio thread; with setNonRealtime (true) frames run inline instead, so
+ *  offline renders are exact.  The worker thread only exists while the
+ *  owner asks for it (setWorkerRunning).
+ *
+ *  processBlock() has ShimmerChorus's signature: the shifted signal, scaled
+ *  by amount.  Hops where amount stays at 0 are not analysed.
+ */
+class SpectralShimmer
+{
+public:
+    static constexpr int MAX_VOICES = 4;
+    static constexpr int OVERLAP    = 4;
+
+    SpectralShimmer() = default;
+    ~SpectralShimmer() { worker.stopThread (-1); }
+
+    /** Offline: frames run inline, deterministically.  Any thread; the
+        audio thread switches over once the worker is idle. */
+    void setNonRealtime (bool shouldBeOffline) noexcept { offlineRequested.store (shouldBeOffline); }
+
+    /**
+     *  Message thread: start or stop the frame thread.  It is only needed
+     *  while this engine plays in real time; without it hops go unanalysed
+     *  (offline, frames run inline either way).  Stopped by prepare().
+     */
+    void setWorkerRunning (bool shouldRun)
+    {
+        if (shouldRun)
+        {
+            worker.startThread();
+            workerRunning.store (true);
+            return;
+        }
+
+        // Once no post can see the worker running, the jobs left run here
+        workerRunning.store (false);
+        while (posting.load())
+            juce::Thread::yield();
+
+        worker.stopThread (-1);
+        finishPostedJobs();
+    }
+
+    /** maxBlockSize: the most samples processBlock() is given in one host callback. */
+    void prepare (double sampleRate, int maxBlockSize)
+    {
+        setWorkerRunning (false);
+
+        // ~43 ms frames whatever the rate: 2048 up to 48 kHz, 4096, 8192
+        order = 11;
+        while (order < 13 && sampleRate >= 88200.0 * (1 << (order - 11)))
+            ++order;
+
+        fftSize = 1 << order;
+        hop     = fftSize / OVERLAP;
+        numBins = fftSize / 2 + 1;
+        fft     = std::make_unique<juce::dsp::FFT> (order);
+
+        window.resize (static_cast<size_t> (fftSize));
+        for (int n = 0; n < fftSize; ++n)
+            window[(size_t) n] = 0.5f - 0.5f * std::cos (juce::MathConstants<float>::twoPi
+                                                         * static_cast<float> (n) / static_cast<float> (fftSize));
+
+        // Frame of hop q plays from hop q + outDelay, never within the callback that posted it
+        outDelay = 1 + juce::jmax (1, (maxBlockSize + hop - 1) / hop);
+        slots    = outDelay + 2;
+
+        inRing.assign (static_cast<size_t> (juce::nextPowerOfTwo (fftSize)), 0.f);
+        ringMask = static_cast<int> (inRing.size()) - 1;
+        jobs     .assign (static_cast<size_t> (slots), Job {});
+        jobFrames.assign (static_cast<size_t> (slots * fftSize), 0.f);
+        outSlots .assign (static_cast<size_t> (slots * hop), 0.f);
+        outHop = std::vector<std::atomic<int64_t>> (static_cast<size_t> (slots));
+
+        frame     .assign (static_cast<size_t> (2 * fftSize), 0.f);
+        ola       .assign (static_cast<size_t> (fftSize), 0.f);
+        lastPhase .assign (static_cast<size_t> (numBins), 0.f);
+        magnitude .assign (static_cast<size_t> (numBins), 0.f);
+        advance   .assign (static_cast<size_t> (numBins), 0.f);
+        shiftedMag.assign (static_cast<size_t> (numBins), 0.f);
+        shiftedAdv.assign (static_cast<size_t> (numBins), 0.f);
+        for (auto& v : synthPhase)
+            v.assign (static_cast<size_t> (numBins), 0.f);
+
+        silence.setRequiredRun (getLatencySamples() + fftSize);
+        nonRealtime = offlineRequested.load();
+        reset();
+    }
+
+    /** Clears all history.  Not concurrent with processBlock(). */
+    void reset()
+    {
+        finishPostedJobs();
+
+        std::fill (inRing.begin(),   inRing.end(),   0.f);
+        std::fill (outSlots.begin(), outSlots.end(), 0.f);
+        for (auto& h : outHop)
+            h.store (-1);
+        clearFrameState();
+        silence.markSilent();
+
+        writePos = validFrom = phase = 0;
+        hopIndex = firstValid = 0;
+        lastPosted = -1;
+        outReady = hopActive = clearPending = false;
+        posted.store (0);
+        done.store (0);
+    }
+
+    /** Audio thread: forget the input history (the engine was switched back in). */
+    void restart() noexcept
+    {
+        // Frames posted so far are stale; the next job starts from a clear
+        // state, with the input before now as silence
+        validFrom    = writePos;
+        firstValid   = hopIndex;
+        outReady     = false;
+        clearPending = true;
+        silence.markSilent();
+    }
+
+    /** Intervals in semitones (up to MAX_VOICES), each at 1/√n.  From the next hop on. */
+    void setVoices (const float* semitones, int numVoices) noexcept
+    {
+        voices.count = juce::jlimit (0, MAX_VOICES, numVoices);
+        voices.gain  = voices.count > 0 ? 1.f / std::sqrt (static_cast<float> (voices.count)) : 0.f;
+        for (int v = 0; v < voices.count; ++v)
+            voices.ratio[(size_t) v] = std::pow (2.f, semitones[v] / 12.f);
+    }
+
+    /** Input → output delay of an unshifted voice. */
+    int getLatencySamples() const noexcept { return fftSize + (outDelay - 1) * hop; }
+
+    /** In place: the shifted signal scaled by amount (indexed per sample, array or constant accessor). */
+    template <typename Amount>
+    void processBlock (float* io, Amount amount, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float x = io[i];
+            inRing[(size_t) (writePos++ & ringMask)] = x;
+            silence.push (x);
+
+            const float a = amount[i];
+            float y = 0.f;
+            if (a >= 0.001f)
+            {
+                hopActive = true;
+                if (outReady)
+                    y = outSlots[(size_t) (slotOffset (hopIndex - outDelay) + phase)] * a;
+            }
+            io[i] = y;
+
+            if (++phase == hop)
+                finishHop();
+        }
+    }
+
+    /** True once the input has been near-silent for longer than a frame + the latency. */
+    bool isSilent() const noexcept { return silence.isSilent(); }
+
+private:
+    /** Voice settings, copied into each posted job. */
+    struct Voices
+    {
+        std::array<float, MAX_VOICES> ratio {};
+        float gain  = 0.f;
+        int   count = 0;
+    };
+
+    struct Job
+    {
+        Voices  voices;
+        int64_t hop   = 0;      // frame ending with this hop (its jobFrames slot holds the input)
+        bool    clear = false;  // frame state starts over: restart(), or hops in between skipped
+    };
+
+    int slotOffset (int64_t hopNumber) const noexcept
+    {
+        return static_cast<int> (hopNumber % slots) * hop;
+    }
+
+    void finishHop() noexcept
+    {
+        phase = 0;
+        const int64_t q = hopIndex++;
+
+        const int64_t queued   = posted.load (std::memory_order_relaxed);
+        const int64_t finished = done.load (std::memory_order_acquire);
+
+        // Switch between worker and inline only while the worker is idle
+        const bool offline = offlineRequested.load (std::memory_order_relaxed);
+        if (offline != nonRealtime && finished == queued)
+            nonRealtime = offline;
+
+        // Hops where shimmer stayed down are not analysed; nor, rather than
+        // waiting, is a hop that finds every job slot still taken, or no
+        // worker to take it
+        if (hopActive && voices.count > 0 && queued - finished < slots)
+        {
+            if (nonRealtime)
+            {
+                // Done before posted, so the idle worker never sees it pending
+                queueJob (q, queued);
+                runFrameJob();
+                posted.store (queued + 1, std::memory_order_release);
+            }
+            else
+            {
+                // setWorkerRunning (false) waits while a post may still reach the worker
+                posting.store (true);
+                if (workerRunning.load())
+                {
+                    queueJob (q, queued);
+                    posted.store (queued + 1, std::memory_order_release);
+                    worker.notify();
+                }
+                posting.store (false);
+            }
+        }
+        hopActive = false;
+
+        // The hop starting now plays the frame of hop − outDelay, if it is done
+        const int64_t playing = hopIndex - outDelay;
+        outReady = playing >= firstValid
+                && outHop[(size_t) (playing % slots)].load (std::memory_order_acquire) == playing;
+    }
+
+    void queueJob (int64_t hopNumber, int64_t jobNumber) noexcept
+    {
+        const int slot = static_cast<int> (jobNumber % slots);
+        auto& job    = jobs[(size_t) slot];
+        job.voices   = voices;
+        job.hop      = hopNumber;
+        job.clear    = clearPending || hopNumber != lastPosted + 1;
+        clearPending = false;
+        lastPosted   = hopNumber;
+
+        // Input before a restart is silence
+        float* f = jobFrames.data() + slot * fftSize;
+        for (int n = 0; n < fftSize; ++n)
+        {
+            const int64_t t = writePos - fftSize + n;
+            f[n] = t >= validFrom ? inRing[(size_t) (t & ringMask)] : 0.f;
+        }
+    }
+
+    void finishPostedJobs()
+    {
+        while (true)
+        {
+            // posted first: an inline job is done before it is posted
+            const int64_t pending = posted.load();
+            if (done.load() >= pending)
+                break;
+
+            if (worker.isThreadRunning())
+                juce::Thread::yield();
+            else
+                runFrameJob();
+        }
+    }
+
+    void clearFrameState() noexcept
+    {
+        std::fill (ola.begin(),       ola.end(),       0.f);
+        std::fill (lastPhase.begin(), lastPhase.end(), 0.f);
+        for (auto& v : synthPhase)
+            std::fill (v.begin(), v.end(), 0.f);
+    }
+
+    // Worker thread (or inline when offline): the next posted frame
+    void runFrameJob() noexcept
+    {
+        const int64_t jobNumber = done.load (std::memory_order_relaxed);
+        const int     slot      = static_cast<int> (jobNumber % slots);
+        const Job&    job       = jobs[(size_t) slot];
+        const float*  input     = jobFrames.data() + slot * fftSize;
+        float*        out       = outSlots.data() + slotOffset (job.hop);
+
+        if (job.clear)
+            clearFrameState();
+
+        // ── Analysis: windowed frame
+        for (int n = 0; n < fftSize; ++n)
+            frame[(size_t) n] = input[n] * window[(size_t) n];
+        std::fill (frame.begin() + fftSize, frame.end(), 0.f);
+        fft->performRealOnlyForwardTransform (frame.data(), true);
+
+        // True phase advance per hop: the bin's expected advance + deviation
+        const float binAdvance = juce::MathConstants<float>::twoPi / static_cast<float> (OVERLAP);
+        for (int k = 0; k < numBins; ++k)
+        {
+            const float re = frame[(size_t) (2 * k)];
+            const float im = frame[(size_t) (2 * k + 1)];
+            const float ph = fastAtan2 (im, re);
+            const float expected = binAdvance * static_cast<float> (k);
+
+            magnitude[(size_t) k] = std::sqrt (re * re + im * im);
+            advance  [(size_t) k] = expected + wrapPhase (ph - lastPhase[(size_t) k] - expected);
+            lastPhase[(size_t) k] = ph;
+        }
+
+        // ── Synthesis: every voice into one spectrum ─────────────────
+        std::fill (frame.begin(), frame.end(), 0.f);
+
+        for (int v = 0; v < job.voices.count; ++v)
+        {
+            const float ratio = job.voices.ratio[(size_t) v];
+            std::fill (shiftedMag.begin(), shiftedMag.end(), 0.f);
+
+            int numShifted = 0;
+            for (int k = 0; k < numBins; ++k)
+            {
+                const int j = static_cast<int> (static_cast<float> (k) * ratio + 0.5f);
+                if (j >= numBins)
+                    break;
+
+                shiftedMag[(size_t) j] += magnitude[(size_t) k];
+                shiftedAdv[(size_t) j]  = advance[(size_t) k] * ratio;
+                numShifted = j + 1;
+            }
+
+            // Bins nothing maps to (every other one an octave up, the top
+            // going up, the top half an octave down) keep their phase
+            auto& synth = synthPhase[(size_t) v];
+            for (int j = 0; j < numShifted; ++j)
+            {
+                if (shiftedMag[(size_t) j] == 0.f)
+                    continue;
+
+                const float p = wrapPhase (synth[(size_t) j] + shiftedAdv[(size_t) j]);
+                synth[(size_t) j] = p;
+
+                float s, c;
+                fastSinCos (p, s, c);
+                frame[(size_t) (2 * j)]     += shiftedMag[(size_t) j] * c;
+                frame[(size_t) (2 * j + 1)] += shiftedMag[(size_t) j] * s;
+            }
+        }
+
+        fft->performRealOnlyInverseTransform (frame.data());
+
+        // ── Overlap-add: Hann² at 4× overlap sums to 1.5 ────────────
+        const float scale = job.voices.gain / 1.5f;
+        for (int n = 0; n < fftSize; ++n)
+            ola[(size_t) n] += frame[(size_t) n] * window[(size_t) n] * scale;
+
+        std::copy_n (ola.begin(), hop, out);
+        std::copy (ola.begin() + hop, ola.end(), ola.begin());
+        std::fill (ola.end() - hop, ola.end(), 0.f);
+
+        outHop[(size_t) (job.hop % slots)].store (job.hop, std::memory_order_release);
+        done.store (jobNumber + 1, std::memory_order_release);
+    }
+
+    // ── Fast phase maths (worker) ────────────────────────────────────
+    static float wrapPhase (float p) noexcept
+    {
+        constexpr float twoPi = juce::MathConstants<float>::twoPi;
+        const float turns = p * (1.f / twoPi);
+        return p - twoPi * static_cast<float> (static_cast<int> (turns + (turns >= 0.f ? 0.5f : -0.5f)));
+    }
+
+    /** atan2, |error| < 1e-5 rad. */
+    static float fastAtan2 (float y, float x) noexcept
+    {
+        const float ax = std::abs (x), ay = std::abs (y);
+        const float mx = juce::jmax (ax, ay);
+        if (mx == 0.f)
+            return 0.f;
+
+        const float a = juce::jmin (ax, ay) / mx;
+        const float s = a * a;
+        float r = ((-0.0464964749f * s + 0.15931422f) * s - 0.327622764f) * s * a + a;
+
+        if (ay > ax) r = juce::MathConstants<float>::halfPi - r;
+        if (x < 0.f) r = juce::MathConstants<float>::pi - r;
+        return y < 0.f ? -r : r;
+    }
+
+    /** sin and cos of p ∈ [−π, π], |error| < 4e-6. */
+    static void fastSinCos (float p, float& s, float& c) noexcept
+    {
+        constexpr float pi = juce::MathConstants<float>::pi, halfPi = juce::MathConstants<float>::halfPi;
+
+        // cos p = sin (π/2 − |p|); sin folds into [−π/2, π/2]
+        const float fs = p > halfPi ? pi - p : (p < -halfPi ? -pi - p : p);
+        s = sinPoly (fs);
+        c = sinPoly (halfPi - std::abs (p));
+    }
+
+    static float sinPoly (float x) noexcept
+    {
+        const float x2 = x * x;
+        return x * (1.f + x2 * (-1.f / 6.f + x2 * (1.f / 120.f + x2 * (-1.f / 5040.f + x2 * (1.f / 362880.f)))));
+    }
+
+    struct Worker : juce::Thread
+    {
+        explicit Worker (SpectralShimmer& o) : juce::Thread ("Spectral shimmer"), owner (o) {}
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                while (true)
+                {
+                    // posted first: an inline job is done before it is posted
+                    const int64_t pending = owner.posted.load (std::memory_order_acquire);
+                    if (owner.done.load (std::memory_order_acquire) >= pending)
+                        break;
+
+                    owner.runFrameJob();
+                }
+
+                wait (-1);
+            }
+        }
+
+        SpectralShimmer& owner;
+    };
+
+    int order = 11, fftSize = 2048, hop = 512, numBins = 1025;
+    int outDelay = 2, slots = 4;   // prepare(): from the block size
+    std::vector<float> window;
+
+    // ── Audio thread ─────────────────────────────────────────────────
+    Voices  voices;
+    std::vector<float> inRing;  // the last frame of input
+    int     ringMask   = 0;
+    int64_t writePos   = 0;     // input samples written
+    int64_t validFrom  = 0;     // first input sample after restart()
+    int     phase      = 0;     // within the hop
+    int64_t hopIndex   = 0;     // current hop
+    int64_t firstValid = 0;     // first hop after restart()
+    int64_t lastPosted = -1;    // hop of the newest job
+    bool    outReady     = false;
+    bool    hopActive    = false;
+    bool    clearPending = false;
+    bool    nonRealtime  = false;   // frames run inline
+    SilenceDetector silence;    // input samples below threshold
+
+    // ── Shared with the worker ────────────────────────────────────────
+    std::vector<Job>   jobs;                       // slots, indexed by job number
+    std::vector<float> jobFrames;                  // slots × fftSize input samples
+    std::vector<float> outSlots;                   // slots output hops, indexed by hop
+    std::vector<std::atomic<int64_t>> outHop;      // hop each output slot holds
+    std::atomic<int64_t> posted { 0 }, done { 0 }; // jobs
+    std::atomic<bool>    offlineRequested { false }, workerRunning { false }, posting { false };
+
+    // ── Worker ────────────────────────────────────────────────────────
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::vector<float> frame, ola, lastPhase, magnitude, advance, shiftedMag, shiftedAdv;
+    std::array<std::vector<float>, MAX_VOICES> synthPhase;
+
+    Worker worker { *this };
+};
@@ -0,0 +1,560 @@
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ *  SpringConvolver – zero-latency convolution with a measured spring-tank
+ *  impulse response, non-uniformly partitioned:
+ *
+ *     IR [0, 64)        direct form                        audio thread
+ *     IR [64, D·1024)   64-sample FFT partitions           audio thread
+ *     IR [D·1024, end)  1024-sample FFT partitions         worker thread
+ *
+ *  Every segment starts no earlier than its own block latency, so the sum is
+ *  the exact convolution with nothing added in front.  A tail block posted at
+ *  the end of input block q is first heard at the start of block q + D, with
+ *  D = 1 + ⌈host block / 1024⌉ (at least 2): the block is always posted and
+ *  played in different host callbacks, and the worker has at least one
+ *  whole tail block (~21 ms at 48 kHz) to deliver it.  A late worker costs
+ *  tail blocks rather than stalling the audio thread; with setNonRealtime
+ *  (true) the tail runs inline instead, so offline renders are exact.  The
+ *  worker thread only exists while the owner asks for it (setWorkerRunning).
+ *
+ *  Partitions are uniformly-partitioned overlap-save (UPOLS).  Spectra are
+ *  kept split-complex, so the multiply-accumulate over the frequency-domain
+ *  delay line runs on juce::dsp::SIMDRegister.
+ *
+ *  Impulse responses become a Kernel (partition spectra) off the audio
+ *  thread and are handed over while the worker is idle.  The input history
+ *  carries over, so a swap continues the tail with the new response, and the
+ *  audio thread never allocates or frees.
+ */
+class SpringConvolver
+{
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int LANES = static_cast<int> (Vec::SIMDNumElements);
+
+    /** Overlap-save convolution in Block-sized partitions (FFT of 2 × Block). */
+    template <int Block, int Order>
+    class Partitions
+    {
+    public:
+        static constexpr int FFT_SIZE = 2 * Block;
+        static constexpr int REGS     = (Block + 1 + LANES - 1) / LANES; // registers per re / im half
+        static constexpr int SPECTRUM = 2 * REGS;                         // registers per split spectrum
+        static_assert ((1 << Order) == FFT_SIZE, "FFT order and block size out of step");
+
+        /** Split spectra of ir, cut into numParts zero-padded partitions. */
+        static void transform (const float* ir, int length, int numParts, Vec* dest)
+        {
+            juce::dsp::FFT fft (Order);
+            std::vector<float> buffer (static_cast<size_t> (2 * FFT_SIZE));
+
+            for (int p = 0; p < numParts; ++p)
+            {
+                std::fill (buffer.begin(), buffer.end(), 0.f);
+                const int n = juce::jlimit (0, Block, length - p * Block);
+                std::copy_n (ir + p * Block, n, buffer.begin());
+
+                fft.performRealOnlyForwardTransform (buffer.data(), true);
+                split (buffer.data(), dest + p * SPECTRUM);
+            }
+        }
+
+        void prepare (int maxParts)
+        {
+            numSlots = juce::jmax (1, maxParts);
+            fdl.assign (static_cast<size_t> (numSlots * SPECTRUM), Vec::expand (0.f));
+            acc.assign (static_cast<size_t> (SPECTRUM), Vec::expand (0.f));
+            history.assign (static_cast<size_t> (Block), 0.f);
+            work.assign (static_cast<size_t> (2 * FFT_SIZE), 0.f);
+            fft = std::make_unique<juce::dsp::FFT> (Order);
+            reset();
+        }
+
+        void reset() noexcept
+        {
+            std::fill (fdl.begin(), fdl.end(), Vec::expand (0.f));
+            std::fill (history.begin(), history.end(), 0.f);
+            newest = 0;
+        }
+
+        /** Takes Block new input samples, writes the next Block output samples. */
+        void process (const float* input, const Vec* kernel, int numParts, float* out) noexcept
+        {
+            jassert (numParts <= numSlots);
+            float* buf = work.data();
+
+            // Window: previous block | this block
+            std::copy_n (history.data(), Block, buf);
+            std::copy_n (input, Block, buf + Block);
+            std::copy_n (input, Block, history.data());
+            fft->performRealOnlyForwardTransform (buf, true);
+
+            // The delay line runs backwards: partition p pairs with slot newest + p
+            newest = (newest == 0 ? numSlots : newest) - 1;
+            split (buf, fdl.data() + newest * SPECTRUM);
+
+            std::fill (acc.begin(), acc.end(), Vec::expand (0.f));
+            Vec* accRe = acc.data();
+            Vec* accIm = accRe + REGS;
+
+            for (int p = 0, slot = newest; p < numParts; ++p)
+            {
+                const Vec* x = fdl.data() + slot * SPECTRUM;
+                const Vec* h = kernel + p * SPECTRUM;
+
+                for (int r = 0; r < REGS; ++r)
+                {
+                    accRe[r] += h[r] * x[r]        - h[REGS + r] * x[REGS + r];
+                    accIm[r] += h[r] * x[REGS + r] + h[REGS + r] * x[r];
+                }
+
+                if (++slot == numSlots) slot = 0;
+            }
+
+            merge (acc.data(), buf);
+            fft->performRealOnlyInverseTransform (buf);
+            std::copy_n (buf + Block, Block, out);
+        }
+
+    private:
+        // Interleaved (re, im) bins 0 … Block ↔ re registers | im registers
+        static void split (const float* bins, Vec* dest) noexcept
+        {
+            alignas (Vec::SIMDRegisterSize) float re[LANES], im[LANES];
+            for (int r = 0; r < REGS; ++r)
+            {
+                for (int l = 0; l < LANES; ++l)
+                {
+                    const int bin = r * LANES + l;
+                    re[l] = bin <= Block ? bins[2 * bin]     : 0.f;
+                    im[l] = bin <= Block ? bins[2 * bin + 1] : 0.f;
+                }
+                dest[r]        = Vec::fromRawArray (re);
+                dest[REGS + r] = Vec::fromRawArray (im);
+            }
+        }
+
+        static void merge (const Vec* src, float* bins) noexcept
+        {
+            alignas (Vec::SIMDRegisterSize) float re[LANES], im[LANES];
+            for (int r = 0; r < REGS; ++r)
+            {
+                src[r]       .copyToRawArray (re);
+                src[REGS + r].copyToRawArray (im);
+                for (int l = 0; l < LANES && r * LANES + l <= Block; ++l)
+                {
+                    bins[2 * (r * LANES + l)]     = re[l];
+                    bins[2 * (r * LANES + l) + 1] = im[l];
+                }
+            }
+        }
+
+        std::unique_ptr<juce::dsp::FFT> fft;
+        std::vector<Vec>   fdl;          // input spectra, numSlots × SPECTRUM
+        std::vector<Vec>   acc;
+        std::vector<float> history;      // previous input block
+        std::vector<float> work;         // FFT in / out
+        int numSlots = 1;
+        int newest   = 0;
+    };
+
+public:
+    static constexpr int    DIRECT_TAPS = 64;
+    static constexpr int    TAIL_BLOCK  = 1024;
+    static constexpr double MAX_SECONDS = 4.0;
+
+    using Head = Partitions<DIRECT_TAPS, 7>;
+    using Tail = Partitions<TAIL_BLOCK, 11>;
+
+    /** Partition spectra of one impulse response (built off the audio thread). */
+    struct Kernel
+    {
+        std::array<float, DIRECT_TAPS> direct {};
+        std::vector<Vec> head;          // headParts spectra
+        std::vector<Vec> tail;          // numTail spectra
+        int headParts = 0;
+        int numTail   = 0;
+        int length    = 0;
+    };
+
+    SpringConvolver() = default;
+    ~SpringConvolver() { worker.stopThread (-1); }
+
+    /** Offline: the tail runs inline, deterministically.  Any thread; the
+        audio thread switches over once the worker is idle. */
+    void setNonRealtime (bool shouldBeOffline) noexcept { offlineRequested.store (shouldBeOffline); }
+
+    /**
+     *  Message thread: start or stop the tail thread.  It is only needed
+     *  while a kernel is in use in real time; without it the tail is dropped
+     *  (offline, it runs inline either way).  Stopped by prepare().
+     */
+    void setWorkerRunning (bool shouldRun)
+    {
+        if (shouldRun)
+        {
+            worker.startThread();
+            workerRunning.store (true);
+            return;
+        }
+
+        // Once no post can see the worker running, the jobs left run here
+        workerRunning.store (false);
+        while (posting.load())
+            juce::Thread::yield();
+
+        worker.stopThread (-1);
+        finishPostedJobs();
+    }
+
+    /** maxBlockSize: the most samples process() is given in one host callback. */
+    void prepare (double sampleRate, int maxBlockSize)
+    {
+        setWorkerRunning (false);
+
+        // The tail of block q plays from block q + tailDelay, never within
+        // the callback that posted it; the head partitions cover the gap
+        tailDelay = 1 + juce::jmax (1, (maxBlockSize + TAIL_BLOCK - 1) / TAIL_BLOCK);
+        tailStart = tailDelay * TAIL_BLOCK;
+        headParts = tailStart / DIRECT_TAPS - 1;
+        tailSlots = tailDelay + 2;
+
+        maxLength = static_cast<int> (MAX_SECONDS * sampleRate);
+        maxTail   = juce::jmax (0, (maxLength - tailStart + TAIL_BLOCK - 1) / TAIL_BLOCK);
+
+        head.prepare (headParts);
+        tail.prepare (maxTail);
+        tailIn .assign (static_cast<size_t> (tailSlots * TAIL_BLOCK), 0.f);
+        tailOut.assign (static_cast<size_t> (tailSlots * TAIL_BLOCK), 0.f);
+        tailDiscard.assign (static_cast<size_t> (TAIL_BLOCK), 0.f);
+        jobs.assign (static_cast<size_t> (tailSlots), Job {});
+        outBlock = std::vector<std::atomic<int64_t>> (static_cast<size_t> (tailSlots));
+
+        // Kernels cut for another block size no longer line up; the owner
+        // builds them again with makeKernel()
+        {
+            const juce::SpinLock::ScopedLockType lock (kernelLock);
+            for (auto* k : { &active, &pending, &retired })
+                if (*k != nullptr && (*k)->headParts != headParts)
+                    k->reset();
+        }
+
+        nonRealtime = offlineRequested.load();
+        reset();
+        applyPendingKernel();
+    }
+
+    /** Clears all history.  Not concurrent with process(). */
+    void reset()
+    {
+        finishPostedJobs();
+
+        head.reset();
+        tail.reset();
+        acc.fill (0.f);
+        headIn.fill (0.f);
+        std::fill (tailIn.begin(),  tailIn.end(),  0.f);
+        std::fill (tailOut.begin(), tailOut.end(), 0.f);
+        for (auto& b : outBlock)
+            b.store (-1);
+
+        phase = tailPhase = 0;
+        block = firstValid = 0;
+        lastPosted = -1;
+        tailWrite  = tailIn.data();
+        tailReady  = clearPending = false;
+        posted.store (0);
+        done.store (0);
+    }
+
+    /** Audio thread: forget the input history (the engine was switched back in). */
+    void restart() noexcept
+    {
+        head.reset();
+        acc.fill (0.f);
+        headIn.fill (0.f);
+        std::fill_n (tailWrite, TAIL_BLOCK, 0.f);
+
+        // Tail blocks posted so far are stale; the next job starts the
+        // worker's history over
+        firstValid   = block;
+        tailReady    = false;
+        clearPending = true;
+    }
+
+    /** Partitions for an impulse response at the prepared rate and block
+        size (not on the audio thread). */
+    std::unique_ptr<Kernel> makeKernel (const float* ir, int length) const
+    {
+        length = juce::jmin (length, maxLength);
+
+        auto kernel = std::make_unique<Kernel>();
+        kernel->length    = length;
+        kernel->headParts = headParts;
+        kernel->numTail   = juce::jlimit (0, maxTail, (length - tailStart + TAIL_BLOCK - 1) / TAIL_BLOCK);
+
+        std::copy_n (ir, juce::jlimit (0, DIRECT_TAPS, length), kernel->direct.begin());
+
+        kernel->head.assign (static_cast<size_t> (headParts * Head::SPECTRUM), Vec::expand (0.f));
+        if (length > DIRECT_TAPS)
+            Head::transform (ir + DIRECT_TAPS, length - DIRECT_TAPS, headParts, kernel->head.data());
+
+        kernel->tail.assign (static_cast<size_t> (kernel->numTail * Tail::SPECTRUM), Vec::expand (0.f));
+        if (kernel->numTail > 0)
+            Tail::transform (ir + tailStart, length - tailStart, kernel->numTail, kernel->tail.data());
+
+        return kernel;
+    }
+
+    /** Message thread: queue a kernel (nullptr unloads); picked up by applyPendingKernel(). */
+    void setKernel (std::unique_ptr<Kernel> kernel)
+    {
+        const juce::SpinLock::ScopedLockType lock (kernelLock);
+        retired.reset();
+        pending = std::move (kernel);
+        kernelPending.store (true);
+    }
+
+    /** Audio thread: swap in a queued kernel once the worker is idle.  Never frees. */
+    void applyPendingKernel() noexcept
+    {
+        if (! kernelPending.load() || done.load (std::memory_order_acquire) != posted.load())
+            return;
+
+        const juce::SpinLock::ScopedTryLockType lock (kernelLock);
+        if (! lock.isLocked() || retired != nullptr)
+            return;
+
+        retired = std::move (active);
+        active  = std::move (pending);
+        kernelPending.store (false);
+    }
+
+    bool hasKernel()    const noexcept { return active != nullptr; }
+    int  getLength()    const noexcept { return active != nullptr ? active->length : 0; }
+    int  getMaxLength() const noexcept { return maxLength; }
+
+    /** Requires hasKernel(). */
+    void process (const float* input, float* output, int numSamples) noexcept
+    {
+        jassert (hasKernel());
+        const Kernel* kernel = active.get();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float x = input[i];
+
+            // Direct form into the accumulator of the next 2 × DIRECT_TAPS outputs
+            float* a = acc.data() + phase;
+            for (int k = 0; k < DIRECT_TAPS; ++k)
+                a[k] += kernel->direct[(size_t) k] * x;
+
+            float y = acc[(size_t) phase];
+            if (tailReady)
+                y += tailOut[(size_t) (slotOffset (block - tailDelay) + tailPhase)];
+
+            headIn[(size_t) phase] = x;
+            tailWrite[tailPhase] = x;
+            output[i] = y;
+
+            if (++phase == DIRECT_TAPS)
+                finishHeadBlock (*kernel);
+
+            if (++tailPhase == TAIL_BLOCK)
+            {
+                finishTailBlock();
+                kernel = active.get();
+            }
+        }
+    }
+
+private:
+    /** One posted tail block. */
+    struct Job
+    {
+        int64_t block = 0;      // its tailIn / tailOut slot
+        bool    clear = false;  // history starts over: restart(), or blocks in between dropped
+    };
+
+    int slotOffset (int64_t tailBlock) const noexcept
+    {
+        return static_cast<int> (tailBlock % tailSlots) * TAIL_BLOCK;
+    }
+
+    void finishHeadBlock (const Kernel& kernel) noexcept
+    {
+        alignas (Vec::SIMDRegisterSize) float out[DIRECT_TAPS];
+        head.process (headIn.data(), kernel.head.data(), kernel.headParts, out);
+
+        // Slide the accumulator one block; the partitions cover the next block
+        std::copy_n (acc.data() + DIRECT_TAPS, DIRECT_TAPS, acc.data());
+        std::fill_n (acc.data() + DIRECT_TAPS, DIRECT_TAPS, 0.f);
+        for (int k = 0; k < DIRECT_TAPS; ++k)
+            acc[(size_t) k] += out[k];
+
+        phase = 0;
+    }
+
+    void finishTailBlock() noexcept
+    {
+        tailPhase = 0;
+        const int64_t q = block++;
+
+        int64_t queued   = posted.load (std::memory_order_relaxed);
+        int64_t finished = done.load (std::memory_order_acquire);
+
+        // Switch between worker and inline only while the worker is idle
+        const bool offline = offlineRequested.load (std::memory_order_relaxed);
+        if (offline != nonRealtime && finished == queued)
+            nonRealtime = offline;
+
+        // Not posted: input that went to the discard block, blocks that find
+        // every job slot taken, and blocks with no worker to take them
+        if (tailWrite != tailDiscard.data() && queued - finished < tailSlots)
+        {
+            if (nonRealtime)
+            {
+                // Done before posted, so the idle worker never sees it pending
+                queueJob (q, queued);
+                runTailJob();
+                posted.store (++queued, std::memory_order_release);
+            }
+            else
+            {
+                // setWorkerRunning (false) waits while a post may still reach the worker
+                posting.store (true);
+                if (workerRunning.load())
+                {
+                    queueJob (q, queued);
+                    posted.store (++queued, std::memory_order_release);
+                    worker.notify();
+                }
+                posting.store (false);
+            }
+        }
+
+        applyPendingKernel();
+
+        // The next block reuses the slot of block − tailSlots; while a job
+        // may still be reading it, that block's input is dropped
+        finished = done.load (std::memory_order_acquire);
+        const bool slotFree = finished == queued
+                           || jobs[(size_t) (finished % tailSlots)].block > block - tailSlots;
+        tailWrite = slotFree ? tailIn.data() + slotOffset (block) : tailDiscard.data();
+
+        // The window starting now plays the tail of block − tailDelay, if it is done
+        const int64_t playing = block - tailDelay;
+        tailReady = playing >= firstValid
+                 && outBlock[(size_t) (playing % tailSlots)].load (std::memory_order_acquire) == playing;
+    }
+
+    void queueJob (int64_t tailBlock, int64_t jobNumber) noexcept
+    {
+        auto& job    = jobs[(size_t) (jobNumber % tailSlots)];
+        job.block    = tailBlock;
+        job.clear    = clearPending || tailBlock != lastPosted + 1;
+        clearPending = false;
+        lastPosted   = tailBlock;
+    }
+
+    void finishPostedJobs()
+    {
+        while (true)
+        {
+            // posted first: an inline job is done before it is posted
+            const int64_t pending = posted.load();
+            if (done.load() >= pending)
+                break;
+
+            if (worker.isThreadRunning())
+                juce::Thread::yield();
+            else
+                runTailJob();
+        }
+    }
+
+    // Worker thread (or inline when offline): the next posted tail block
+    void runTailJob() noexcept
+    {
+        const int64_t jobNumber = done.load (std::memory_order_relaxed);
+        const Job&    job       = jobs[(size_t) (jobNumber % tailSlots)];
+
+        if (job.clear)
+            tail.reset();
+
+        const Kernel* kernel = active.get();
+        tail.process (tailIn.data() + slotOffset (job.block),
+                      kernel != nullptr ? kernel->tail.data() : nullptr,
+                      kernel != nullptr ? juce::jmin (kernel->numTail, maxTail) : 0,
+                      tailOut.data() + slotOffset (job.block));
+
+        outBlock[(size_t) (job.block % tailSlots)].store (job.block, std::memory_order_release);
+        done.store (jobNumber + 1, std::memory_order_release);
+    }
+
+    struct Worker : juce::Thread
+    {
+        explicit Worker (SpringConvolver& o) : juce::Thread ("Spring IR tail"), owner (o) {}
+
+        void run() override
+        {
+            while (! threadShouldExit())
+            {
+                while (true)
+                {
+                    // posted first: an inline job is done before it is posted
+                    const int64_t pending = owner.posted.load (std::memory_order_acquire);
+                    if (owner.done.load (std::memory_order_acquire) >= pending)
+                        break;
+
+                    owner.runTailJob();
+                }
+
+                wait (-1);
+            }
+        }
+
+        SpringConvolver& owner;
+    };
+
+    // ── Audio thread ─────────────────────────────────────────────────
+    Head head;
+    std::array<float, 2 * DIRECT_TAPS> acc {};      // outputs from now on
+    std::array<float, DIRECT_TAPS>     headIn {};
+    int     phase      = 0;                         // within the head block
+    int     tailPhase  = 0;                         // within the tail block
+    int64_t block      = 0;                         // current tail block
+    int64_t firstValid = 0;                         // first tail block after restart()
+    int64_t lastPosted = -1;                        // tail block of the newest job
+    float*  tailWrite  = nullptr;                   // this block's tailIn slot, or tailDiscard
+    bool    tailReady    = false;
+    bool    clearPending = false;
+    bool    nonRealtime  = false;                   // tail runs inline
+    std::vector<float> tailDiscard;                 // input while the worker lags
+
+    // ── Shared with the worker ────────────────────────────────────────
+    Tail tail;
+    std::vector<float> tailIn, tailOut;             // tailSlots blocks each, indexed by block
+    std::vector<Job>   jobs;                        // tailSlots, indexed by job number
+    std::vector<std::atomic<int64_t>> outBlock;     // tail block each tailOut slot holds
+    std::atomic<int64_t> posted { 0 }, done { 0 };  // jobs
+    std::atomic<bool>    offlineRequested { false }, workerRunning { false }, posting { false };
+    int     maxLength = 0, maxTail = 0;
+    int     tailDelay = 2, tailStart = 2 * TAIL_BLOCK;   // prepare(): from the block size
+    int     headParts = 2 * TAIL_BLOCK / DIRECT_TAPS - 1;
+    int     tailSlots = 4;                          // tail in / out blocks in flight
+
+    // ── Kernel hand-over ──────────────────────────────────────────────
+    std::unique_ptr<Kernel> active, pending, retired;
+    juce::SpinLock          kernelLock;
+    std::atomic<bool>       kernelPending { false };
+
+    Worker worker { *this };
+};
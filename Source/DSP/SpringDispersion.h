@@ -0,0 +1,119 @@
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/**
+ *  SpringDispersion – the "drip" of a real spring: a long cascade of
+ *  stretched first-order allpasses whose group delay rises with frequency,
+ *  so a click smears into a chirp.
+ *
+ *   • Section:  H(z) = (a + z^-K) / (1 + a z^-K)
+ *               y[n] = a·(x[n] − y[n−K]) + x[n−K]
+ *   • NUM_SECTIONS in series, one coefficient, one stretch K; the sweep
+ *     spans 0 … fs / 2K (~3 kHz) and repeats above it, like the spring's
+ *     own band-limited chirp
+ *   • Magnitude is flat — the stage only moves energy in time
+ *
+ *  Vectorised along time: a section's output depends only on samples at
+ *  least K back, and K is a multiple of the SIMD width, so LANES consecutive
+ *  samples pass through every section as one juce::dsp::SIMDRegister.  Each
+ *  section keeps its last K inputs / outputs as a ring of registers, all
+ *  sections on the same ring position.  Samples off a register boundary
+ *  (odd block lengths) take a scalar path through the same ring.
+ */
+class SpringDispersion
+{
+public:
+    static constexpr int   NUM_SECTIONS = 128;
+    static constexpr float COEFF        = 0.65f;
+    static constexpr int   STRETCH_STEP = 8;    // K per 48 kHz of sample rate
+
+    void prepare (double sampleRate)
+    {
+        stretch = STRETCH_STEP * juce::jmax (1, juce::roundToInt (sampleRate / 48000.0));
+        state.assign (static_cast<size_t> (stretch / LANES * NUM_SECTIONS * 2), Vec::expand (0.f));
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        std::fill (state.begin(), state.end(), Vec::expand (0.f));
+        pos = 0;
+    }
+
+    /** Time for a click to leave the cascade: twice the slowest group delay. */
+    int getTailSamples() const noexcept
+    {
+        // Peak group delay of one section: K (1 + a) / (1 − a)
+        return static_cast<int> (std::ceil (2.0 * NUM_SECTIONS * stretch
+                                            * (1.0 + COEFF) / (1.0 - COEFF)));
+    }
+
+    float processSample (float x) noexcept
+    {
+        const size_t lane = static_cast<size_t> (pos % LANES);
+        Vec* s = ringSlot (pos / LANES);
+
+        for (int i = 0; i < NUM_SECTIONS; ++i, s += 2)
+        {
+            const float xOld = s[0].get (lane);
+            const float yOld = s[1].get (lane);
+            const float y    = (x - yOld) * COEFF + xOld;
+            s[0].set (lane, x);
+            s[1].set (lane, y);
+            x = y;
+        }
+
+        if (++pos == stretch) pos = 0;
+        return x;
+    }
+
+    /** In place; whole registers wherever the ring position allows. */
+    void processBlock (float* io, int numSamples) noexcept
+    {
+        alignas (Vec::SIMDRegisterSize) float lanes[LANES];
+
+        int i = 0;
+        while (i < numSamples)
+        {
+            if (pos % LANES != 0 || numSamples - i < LANES)
+            {
+                io[i] = processSample (io[i]);
+                ++i;
+                continue;
+            }
+
+            std::copy_n (io + i, LANES, lanes);
+            Vec v = Vec::fromRawArray (lanes);
+            Vec* s = ringSlot (pos / LANES);
+
+            for (int k = 0; k < NUM_SECTIONS; ++k, s += 2)
+            {
+                const Vec y = (v - s[1]) * COEFF + s[0];
+                s[0] = v;
+                s[1] = y;
+                v = y;
+            }
+
+            v.copyToRawArray (lanes);
+            std::copy_n (lanes, LANES, io + i);
+
+            if ((pos += LANES) == stretch) pos = 0;
+            i += LANES;
+        }
+    }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int LANES = static_cast<int> (Vec::SIMDNumElements);
+    static_assert (STRETCH_STEP % LANES == 0, "stretch must hold whole registers");
+
+    // Slot-major: the sections' (x, y) pairs for one ring position are adjacent
+    Vec* ringSlot (int slot) noexcept { return state.data() + slot * NUM_SECTIONS * 2; }
+
+    std::vector<Vec> state;
+    int stretch = STRETCH_STEP;
+    int pos     = 0;     // sample index mod stretch
+};
@@ -1,8 +1,14 @@
 #pragma once
 #include <JuceHeader.h>
-#include <vector>
+#include "SilenceDetector.h"
+#include "DelayLine.h"
+#include "SpringDispersion.h"
+#include "SpringConvolver.h"
+#include "HalfbandOversampler.h"
+#include <algorithm>
 #include <array>
 #include <cmath>
+#include <numeric>
 
 /**
  *  SpringReverb – Schroeder-based reverberator tuned for spring character.
@@ -13,6 +19,33 @@
  *   • Series allpass → diffusion / chirp
  *   • Gentle pre-delay (~8 ms)
  *
+ *  Storage: one DelayLine per bank — the 8 combs share interleaved frames,
+ *  as do the 4 allpasses — so every tap is a masked index, no wrap checks.
+ *
+ *  Comb bank: structure of arrays, one SIMD lane per comb.  The eight taps
+ *  are gathered into one row, then damping one-poles, feedback and the new
+ *  frame run as register operations (two SSE / NEON registers, one AVX).
+ *
+ *  Engines (setEngine), sharing the line bank, allpasses and boing:
+ *   • SCHROEDER — 8 parallel damped combs (the classic spring tank)
+ *   • FDN       — 8-line feedback delay network: longer lines, per-line
+ *                 damping, orthogonal Hadamard mixing by fast butterflies
+ *                 (24 add/sub, no multiplies).  Every echo is re-spread
+ *                 over all lines, so the tail thickens much faster for
+ *                 the same work per sample
+ *   • CONVOLUTION — a measured tank response (setImpulseResponse) through
+ *                 SpringConvolver, in place of tank, allpasses and boing;
+ *                 falls back to SCHROEDER until a response is loaded
+ *
+ *  Optional chirp (setChirp): the tank input runs through SpringDispersion,
+ *  a 128-section stretched allpass cascade, in register-wide chunks.
+ *
+ *  Tank rate: a spring is band-limited to ~5 kHz, so at 88.2 kHz and up the
+ *  pre-delayed signal is decimated by 2 or 4 (half-band stages, chosen from
+ *  the sample rate so the tank runs at 44.1 / 48 kHz), chirp and tank run
+ *  there, and the output is interpolated back.  The filters' latency comes
+ *  off the pre-delay, so the onset stays at ~8 ms.
+ *
  *  v1.5: Added "boing" attack resonator
  *   • Digital resonator at 1200 Hz (spring mechanical resonance)
  *   • ~200 ms exponential decay — characteristic metallic "boing" ringing
@@ -24,39 +57,66 @@ public:
     static constexpr int NUM_COMBS   = 8;
     static constexpr int NUM_ALLPASS = 4;
 
-    void prepare (double newSampleRate)
+    // Tank engines (setEngine)
+    static constexpr int SCHROEDER   = 0;
+    static constexpr int FDN         = 1;
+    static constexpr int CONVOLUTION = 2;
+    static constexpr int NUM_ENGINES = 3;
+
+    static constexpr double MIN_TANK_RATE   = 44100.0;
+    static constexpr int    MAX_TANK_FACTOR = 4;
+
+    /** maxBlockSize: the most host-rate samples in one callback. */
+    void prepare (double newSampleRate, int maxBlockSize)
     {
         sampleRate = newSampleRate;
 
+        tankFactor = 1;
+        while (tankFactor < MAX_TANK_FACTOR && sampleRate / (2 * tankFactor) >= MIN_TANK_RATE)
+            tankFactor *= 2;
+        tankRate = sampleRate / tankFactor;
+
         // Comb filter delay times (ms) – spring-tuned, mutually prime
         const float combMs[NUM_COMBS] = {
             25.31f, 26.94f, 28.96f, 30.75f,
             32.25f, 33.84f, 35.28f, 36.80f
         };
+        // FDN line lengths (ms) — longer and wider spread than the combs;
+        // the mixing matrix provides the density
+        const float fdnMs[NUM_COMBS] = {
+            21.73f, 24.91f, 27.29f, 31.87f,
+            35.17f, 38.63f, 43.09f, 47.51f
+        };
         // Allpass delay times (ms)
         const float apMs[NUM_ALLPASS] = { 5.10f, 7.73f, 10.00f, 12.61f };
         // Pre-delay (~8 ms)
         const float preMs = 8.0f;
 
         auto msToSamples = [&] (float ms) {
-            return static_cast<int> (ms * 0.001 * sampleRate) + 1;
+            return static_cast<int> (ms * 0.001 * tankRate) + 1;
         };
 
-        // Pre-delay
-        preDelayBuf.assign (msToSamples (preMs), 0.0f);
-        preDelayPos = 0;
+        // Pre-delay (host rate), less the decimate + interpolate latency
+        resampleLatency = getResampleLatency();
+        preDelayLen = juce::jmax (1, static_cast<int> (preMs * 0.001f * sampleRate) + 1 - resampleLatency);
+        preDelay.setMaximumDelay (preDelayLen);
+        dispersion.prepare (tankRate);
+        convolver .prepare (tankRate, (maxBlockSize + tankFactor - 1) / tankFactor);
+        resetResampler();
 
         for (int i = 0; i < NUM_COMBS; ++i)
         {
-            combBufs[i].assign (msToSamples (combMs[i]), 0.0f);
-            combPos[i] = 0;
-            combState[i] = 0.0f;
+            combLen[i] = msToSamples (combMs[i]);
+            fdnLen[i]  = msToSamples (fdnMs[i]);
         }
+        combState.fill (Vec::expand (0.0f));
+
         for (int i = 0; i < NUM_ALLPASS; ++i)
-        {
-            apBufs[i].assign (msToSamples (apMs[i]), 0.0f);
-            apPos[i] = 0;
-        }
+            apLen[i] = msToSamples (apMs[i]);
+
+        combs    .setMaximumDelay (juce::jmax (*std::max_element (combLen.begin(), combLen.end()),
+                                               *std::max_element (fdnLen.begin(),  fdnLen.end())));
+        allpasses.setMaximumDelay (*std::max_element (apLen.begin(),   apLen.end()));
 
         // ── "Boing" resonator (spring mechanical resonance at ~1200 Hz) ─
         //
@@ -71,7 +131,7 @@ public:
         //     Peak gain at ω₀ ≈ 1 / (2·(1−r)·sin(ω₀))
         //     So  B0 = 2·(1−r)·sin(ω₀)  gives unity peak gain.
         {
-            const float sr_f  = static_cast<float> (sampleRate);
+            const float sr_f  = static_cast<float> (tankRate);
             const float f0    = 1200.f;
             const float tau   = 0.200f; // seconds
             const float bw    = 1.f / (juce::MathConstants<float>::pi * tau);
@@ -85,53 +145,410 @@ public:
             boingY2   = 0.f;
         }
 
+        // Silent = pre-delay holds silence and the tank output stayed below
+        // threshold for longer than one pass through its longest path
+        {
+            int tankPath = getLongestLine();
+            for (const auto len : apLen) tankPath += len;
+
+            inputSilence .setRequiredRun (getInputPath());
+            outputSilence.setRequiredRun (tankPath);
+            inputSilence .markSilent();
+            outputSilence.markSilent();
+        }
+
+        fdnGainValid = false;   // line lengths changed with the rate
         setSize    (0.5f);
         setDamping (0.5f);
     }
 
     void reset()
     {
-        std::fill (preDelayBuf.begin(), preDelayBuf.end(), 0.0f);
-        preDelayPos = 0;
-        for (int i = 0; i < NUM_COMBS;   ++i) { std::fill (combBufs[i].begin(), combBufs[i].end(), 0.0f); combState[i] = 0.0f; combPos[i] = 0; }
-        for (int i = 0; i < NUM_ALLPASS; ++i) { std::fill (apBufs[i].begin(),   apBufs[i].end(),   0.0f); apPos[i] = 0; }
+        preDelay .clear();
+        dispersion.reset();
+        convolver .reset();
+        resetResampler();
+        combs    .clear();
+        allpasses.clear();
+        combState.fill (Vec::expand (0.0f));
         boingY1 = boingY2 = 0.f;
+        inputSilence .markSilent();
+        outputSilence.markSilent();
     }
 
     float process (float input)
     {
         // ── Pre-delay ─────────────────────────────────────────────────
-        float delayed = preDelayBuf[preDelayPos];
-        preDelayBuf[preDelayPos] = input;
-        if (++preDelayPos >= static_cast<int> (preDelayBuf.size())) preDelayPos = 0;
+        const float delayed = *preDelay.frame (preDelay.getWritePos() - preDelayLen);
+        preDelay.push (input);
+        inputSilence.push (input);
 
-        // ── Parallel comb filters ─────────────────────────────────────
-        float combSum = 0.0f;
-        for (int i = 0; i < NUM_COMBS; ++i)
+        return processHostSample (delayed);
+    }
+
+    /** In-place block version of process(), run through the split form. */
+    void processBlock (float* io, int numSamples)
+    {
+        float out[CHUNK];
+
+        for (int done = 0; done < numSamples;)
         {
-            auto& buf  = combBufs[i];
-            int   bsz  = static_cast<int> (buf.size());
+            const int n = juce::jmin (numSamples - done, preDelayLen, CHUNK);
+            readBlock  (out, n);
+            writeBlock (io + done, n);
+            std::copy_n (out, n, io + done);
+            done += n;
+        }
+    }
 
-            float d = buf[combPos[i]];
-            // Lowpass-in-the-loop (tone / damping)
-            combState[i] = d * (1.0f - damp) + combState[i] * damp;
-            buf[combPos[i]] = delayed + combState[i] * roomCoeff;
-            if (++combPos[i] >= bsz) combPos[i] = 0;
-            combSum += d;
+    /**
+     *  Split form of processBlock() for use inside a feedback loop.
+     *  The tank only ever sees pre-delayed input, so a sub-block of up to
+     *  getPreDelaySamples() can be rendered before its input is known;
+     *  writeBlock() must follow with the same numSamples.
+     */
+    void readBlock (float* out, int numSamples)
+    {
+        jassert (numSamples <= preDelayLen);
+        const int readPos = preDelay.getWritePos() - preDelayLen;
+
+        if (tankFactor > 1)
+        {
+            // Tank at a reduced rate: decimate a chunk, run chirp and engine
+            // over all of its tank samples at once, interpolate them back
+            float tank[CHUNK];
+
+            for (int done = 0; done < numSamples;)
+            {
+                const int n = juce::jmin (numSamples - done, CHUNK * tankFactor);
+                const int numTank = decimate (readPos + done, n, tank);
+                processTankBlock (tank, numTank);
+                interpolate (tank, out + done, n);
+                done += n;
+            }
+            return;
+        }
+
+        // Tank at the host rate: whole chunks through chirp and engine
+        for (int done = 0; done < numSamples; done += CHUNK)
+        {
+            const int n = juce::jmin (numSamples - done, CHUNK);
+            for (int i = 0; i < n; ++i)
+                out[done + i] = *preDelay.frame (readPos + done + i);
+
+            processTankBlock (out + done, n);
         }
-        float out = combSum * (1.0f / NUM_COMBS) * 0.7f;
+    }
+
+    void writeBlock (const float* input, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            preDelay.push (input[i]);
+            inputSilence.push (input[i]);
+        }
+    }
+
+    /** Input → tank latency; upper bound for readBlock() sub-blocks. */
+    int getPreDelaySamples() const noexcept { return preDelayLen; }
+
+    /** True when nothing is left in the pre-delay and the tank has rung out. */
+    bool isSilent() const noexcept { return inputSilence.isSilent() && outputSilence.isSilent(); }
+
+    /** Time for the tank to decay by 100 dB at the current size. */
+    double getTailSeconds() const noexcept
+    {
+        const double input = (double) getInputPath() / sampleRate;
+
+        if (engine == CONVOLUTION && convolver.hasKernel())
+            return (double) convolver.getLength() / tankRate + input;
+
+        // Both feedback tanks lose roomCoeff per comb-length pass (the FDN
+        // gains are matched to it), the FDN measured on the longest comb for safety
+        const int longest = *std::max_element (combLen.begin(), combLen.end());
+
+        const double passes = std::log (1.0e-5) / std::log ((double) roomCoeff);
+        return passes * (double) longest / tankRate + input;
+    }
+
+    /** 0..1 — controls decay time */
+    void setSize (float s)
+    {
+        const float newCoeff = 0.70f + s * 0.27f;
+        if (newCoeff == roomCoeff && fdnGainValid)
+            return;
+
+        roomCoeff = newCoeff;
+        updateFdnGains();
+    }
+
+    /**
+     *  SCHROEDER, FDN or CONVOLUTION.  Switching clears the tank (the feedback
+     *  engines share its lines, the convolver forgets its input history); the
+     *  pre-delay keeps its contents.
+     */
+    void setEngine (int newEngine) noexcept
+    {
+        newEngine = juce::jlimit (0, NUM_ENGINES - 1, newEngine);
+        if (newEngine == engine)
+            return;
+
+        engine = newEngine;
+        if (engine == CONVOLUTION)
+            convolver.restart();
+
+        combs    .clear();
+        allpasses.clear();
+        combState.fill (Vec::expand (0.0f));
+        boingY1 = boingY2 = 0.f;
+        outputSilence.markSilent();
+
+        int tankPath = getLongestLine();
+        for (const auto len : apLen) tankPath += len;
+        outputSilence.setRequiredRun (tankPath);
+    }
+
+    int getEngine() const noexcept { return engine; }
+
+    /** Spring dispersion on the tank input; its state restarts when enabled. */
+    void setChirp (bool shouldChirp) noexcept
+    {
+        if (shouldChirp == chirp)
+            return;
+
+        chirp = shouldChirp;
+        dispersion.reset();
+        inputSilence.setRequiredRun (getInputPath());
+    }
+
+    bool getChirp() const noexcept { return chirp; }
+
+    /** Rate the tank runs at: the host rate divided by 1, 2 or 4. */
+    double getTankSampleRate() const noexcept { return tankRate; }
+
+    /**
+     *  Measured tank response for the CONVOLUTION engine, at the tank
+     *  sample rate (at most SpringConvolver::MAX_SECONDS).  Builds the
+     *  partitions here, so call it off the audio thread; length 0 unloads.
+     */
+    void setImpulseResponse (const float* ir, int length)
+    {
+        convolver.setKernel (length > 0 ? convolver.makeKernel (ir, length) : nullptr);
+    }
+
+    /** Offline rendering: the convolution tail runs inline.  Any thread. */
+    void setNonRealtime (bool shouldBeOffline) noexcept { convolver.setNonRealtime (shouldBeOffline); }
+
+    /** Message thread: the CONVOLUTION engine's tail thread, needed only while
+        that engine plays a response in real time.  prepare() stops it. */
+    void setWorkerRunning (bool shouldRun) { convolver.setWorkerRunning (shouldRun); }
+
+    /** 0..1 — controls high-frequency damping */
+    void setDamping (float d) { damp = d * 0.45f; }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    using TankStage = HalfbandStage<16>;   // tank ↔ 2×, sharp
+    using HighStage = HalfbandStage<6>;    // 2× ↔ 4×, wide transition band
+    static constexpr int LANES          = static_cast<int> (Vec::SIMDNumElements);
+    static constexpr int COMB_REGISTERS = NUM_COMBS / LANES;
+    static_assert (NUM_COMBS % LANES == 0, "the comb bank must fill whole registers");
+
+    double sampleRate = 44100.0;
+    double tankRate   = 44100.0;
+    int    tankFactor = 1;
+
+    TankStage tankStage;
+    HighStage highStage;
+    std::array<Vec, MAX_TANK_FACTOR> hostIn, hostOut;
+    int hostPhase       = 0;
+    int resampleLatency = 0;
+
+    // Input → tank output, host samples: pre-delay, resampling and the
+    // dispersion's ring-out when chirping
+    int getInputPath() const noexcept
+    {
+        return preDelayLen + resampleLatency
+             + (chirp ? dispersion.getTailSamples() * tankFactor : 0);
+    }
+
+    // ── Tank-rate resampling ─────────────────────────────────────────
+    // Host samples collect in hostIn; each full period is decimated to one
+    // tank sample, and the tank's answer is interpolated into the host
+    // samples played during the next period.
+    int getResampleLatency() const noexcept
+    {
+        // One period of buffering, plus each stage's down + up delay
+        float latency = 0.f;
+        if (tankFactor >= 2) latency += TankStage::LATENCY * (float) tankFactor + (float) tankFactor;
+        if (tankFactor == 4) latency += HighStage::LATENCY * 2.f;
+        return juce::roundToInt (latency);
+    }
+
+    void resetResampler() noexcept
+    {
+        tankStage.reset();
+        highStage.reset();
+        hostIn .fill (Vec::expand (0.f));
+        hostOut.fill (Vec::expand (0.f));
+        hostPhase = 0;
+    }
+
+    float processHostSample (float delayed) noexcept
+    {
+        if (tankFactor == 1)
+        {
+            processTankBlock (&delayed, 1);
+            return delayed;
+        }
+
+        hostIn[(size_t) hostPhase] = Vec::expand (delayed);
+        const float out = hostOut[(size_t) hostPhase].get (0);
+
+        if (++hostPhase == tankFactor)
+        {
+            hostPhase = 0;
+
+            float sample = downsamplePeriod();
+            processTankBlock (&sample, 1);
+            upsamplePeriod (sample);
+        }
+
+        return out;
+    }
+
+    // Pre-delayed host samples from readPos into hostIn; each completed
+    // period is decimated into tank[] (hostPhase is left for interpolate()).
+    // Returns the tank samples written, at most CHUNK for CHUNK periods.
+    int decimate (int readPos, int numSamples, float* tank) noexcept
+    {
+        int numTank = 0;
+        for (int i = 0, phase = hostPhase; i < numSamples; ++i)
+        {
+            hostIn[(size_t) phase] = Vec::expand (*preDelay.frame (readPos + i));
+            if (++phase == tankFactor)
+            {
+                phase = 0;
+                tank[numTank++] = downsamplePeriod();
+            }
+        }
+        return numTank;
+    }
+
+    // Host output of the samples decimate() consumed; the tank's answer to
+    // each period plays during the next one, as in processHostSample()
+    void interpolate (const float* tank, float* out, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            out[i] = hostOut[(size_t) hostPhase].get (0);
+            if (++hostPhase == tankFactor)
+            {
+                hostPhase = 0;
+                upsamplePeriod (*tank++);
+            }
+        }
+    }
+
+    float downsamplePeriod() noexcept
+    {
+        Vec high[2], tank;
+        if (tankFactor == 4)
+        {
+            highStage.downsample (hostIn.data(), high, 2);
+            tankStage.downsample (high, &tank, 1);
+        }
+        else
+        {
+            tankStage.downsample (hostIn.data(), &tank, 1);
+        }
+        return tank.get (0);
+    }
+
+    void upsamplePeriod (float sample) noexcept
+    {
+        const Vec tank = Vec::expand (sample);
+        Vec high[2];
+        if (tankFactor == 4)
+        {
+            tankStage.upsample (&tank, high, 1);
+            highStage.upsample (high, hostOut.data(), 2);
+        }
+        else
+        {
+            tankStage.upsample (&tank, hostOut.data(), 1);
+        }
+    }
+
+    // Tank-rate samples, in place: chirp, then the engine
+    void processTankBlock (float* io, int numSamples) noexcept
+    {
+        if (chirp)
+            dispersion.processBlock (io, numSamples);
+
+        if (usesConvolution())
+            convolver.process (io, io, numSamples);
+        else
+            for (int i = 0; i < numSamples; ++i)
+                io[i] = processTank (io[i]);
+
+        for (int i = 0; i < numSamples; ++i)
+            outputSilence.push (io[i]);
+    }
+
+    bool usesConvolution() noexcept
+    {
+        if (engine != CONVOLUTION)
+            return false;
+
+        convolver.applyPendingKernel();
+        return convolver.hasKernel();
+    }
+
+    int getLongestLine() const noexcept
+    {
+        // Any response up to the convolver's capacity may be swapped in
+        if (engine == CONVOLUTION)
+            return convolver.getMaxLength();
+
+        const auto& len = engine == FDN ? fdnLen : combLen;
+        return *std::max_element (len.begin(), len.end());
+    }
+
+    // FDN line gains: roomCoeff per mean comb length, so both engines decay
+    // alike at the same size; the Hadamard 1/√N normalisation is folded in
+    void updateFdnGains() noexcept
+    {
+        const double refLen = std::accumulate (combLen.begin(), combLen.end(), 0.0) / NUM_COMBS;
+
+        alignas (Vec::SIMDRegisterSize) float gains[NUM_COMBS];
+        for (int i = 0; i < NUM_COMBS; ++i)
+            gains[i] = static_cast<float> (std::pow ((double) roomCoeff, fdnLen[i] / refLen)
+                                           / std::sqrt ((double) NUM_COMBS));
+
+        for (int r = 0; r < COMB_REGISTERS; ++r)
+            fdnGain[(size_t) r] = Vec::fromRawArray (gains + r * LANES);
+
+        fdnGainValid = true;
+    }
+
+    // ─────────────────────────────────────────────────────────────────
+    // Tank (combs or FDN) → allpasses → boing, fed with the pre-delayed input
+    float processTank (float delayed)
+    {
+        float out = engine == FDN ? processFdn (delayed) : processCombs (delayed);
 
         // ── Series allpass filters ────────────────────────────────────
+        const int apPos = allpasses.getWritePos();
+        std::array<float, NUM_ALLPASS> apIn;
         for (int i = 0; i < NUM_ALLPASS; ++i)
         {
-            auto& buf  = apBufs[i];
-            int   bsz  = static_cast<int> (buf.size());
-            float d    = buf[apPos[i]];
-            float v    = out + d * (-0.5f);
-            buf[apPos[i]] = out + d * 0.5f;
-            if (++apPos[i] >= bsz) apPos[i] = 0;
+            const float d = allpasses.frame (apPos - apLen[i])[i];
+            const float v = out + d * (-0.5f);
+            apIn[i] = out + d * 0.5f;
             out = d + v * (-0.5f);
         }
+        allpasses.push (apIn.data());
 
         // ── "Boing" resonator — spring mechanical resonance ───────────
         // The resonator is fed by the pre-delayed input and rings at 1200 Hz
@@ -147,24 +564,120 @@ public:
         return out;
     }
 
-    /** 0..1 — controls decay time */
-    void setSize (float s)    { roomCoeff = 0.70f + s * 0.27f; }
+    float processCombs (float delayed)
+    {
+        // ── Parallel comb filters, one lane each ──────────────────────
+        const int combPos = combs.getWritePos();
+        alignas (Vec::SIMDRegisterSize) float row[NUM_COMBS];
+        for (int i = 0; i < NUM_COMBS; ++i)
+            row[i] = combs.frame (combPos - combLen[i])[i];
 
-    /** 0..1 — controls high-frequency damping */
-    void setDamping (float d) { damp = d * 0.45f; }
+        const Vec input = Vec::expand (delayed);
+        Vec combSum = Vec::expand (0.0f);
+        for (int r = 0; r < COMB_REGISTERS; ++r)
+        {
+            const Vec d = Vec::fromRawArray (row + r * LANES);
+            // Lowpass-in-the-loop (tone / damping)
+            auto& state = combState[(size_t) r];
+            state    = d * (1.0f - damp) + state * damp;
+            combSum += d;
+            (input + state * roomCoeff).copyToRawArray (row + r * LANES); // row becomes the new frame
+        }
+        combs.push (row);
+        return combSum.sum() * (1.0f / NUM_COMBS) * 0.7f;
+    }
 
-private:
-    double sampleRate = 44100.0;
+    float processFdn (float delayed)
+    {
+        // Alternating signs: input and output taps are not the Hadamard's
+        // own (1, 1, …) eigenvector, so every line is excited and heard
+        struct alignas (Vec::SIMDRegisterSize) Signs { float lane[NUM_COMBS]; };
+        static constexpr Signs signs { { 1.f, -1.f, 1.f, -1.f, 1.f, -1.f, 1.f, -1.f } };
+        static_assert (NUM_COMBS == 8, "signs cover one entry per line");
+
+        const int pos = combs.getWritePos();
+        alignas (Vec::SIMDRegisterSize) float row[NUM_COMBS];
+        for (int i = 0; i < NUM_COMBS; ++i)
+            row[i] = combs.frame (pos - fdnLen[i])[i];
+
+        // Per-line damping + decay gain, one lane per line
+        Vec outSum = Vec::expand (0.0f);
+        for (int r = 0; r < COMB_REGISTERS; ++r)
+        {
+            const Vec d    = Vec::fromRawArray (row + r * LANES);
+            const Vec sign = Vec::fromRawArray (signs.lane + r * LANES);
+            auto& state = combState[(size_t) r];
+            state   = d * (1.0f - damp) + state * damp;
+            outSum += d * sign;
+            (state * fdnGain[(size_t) r]).copyToRawArray (row + r * LANES);
+        }
+
+        hadamard (row);
+
+        const Vec input = Vec::expand (delayed);
+        for (int r = 0; r < COMB_REGISTERS; ++r)
+            (Vec::fromRawArray (row + r * LANES) + input * Vec::fromRawArray (signs.lane + r * LANES))
+                .copyToRawArray (row + r * LANES);
+
+        combs.push (row);
+        return outSum.sum() * (1.0f / NUM_COMBS) * 0.7f;
+    }
+
+    // Unnormalised fast Walsh–Hadamard transform: butterflies a ± b, whole
+    // registers while the span covers a register, then within one
+    static void hadamard (float* row) noexcept
+    {
+        for (int span = NUM_COMBS / 2; span >= 1; span /= 2)
+        {
+            for (int i = 0; i < NUM_COMBS; i += 2 * span)
+            {
+                if (span >= LANES)
+                {
+                    for (int j = i; j < i + span; j += LANES)
+                    {
+                        const Vec a = Vec::fromRawArray (row + j);
+                        const Vec b = Vec::fromRawArray (row + j + span);
+                        (a + b).copyToRawArray (row + j);
+                        (a - b).copyToRawArray (row + j + span);
+                    }
+                }
+                else
+                {
+                    for (int j = i; j < i + span; ++j)
+                    {
+                        const float a = row[j], b = row[j + span];
+                        row[j]        = a + b;
+                        row[j + span] = a - b;
+                    }
+                }
+            }
+        }
+    }
+
+    static constexpr int CHUNK = 64;                  // processBlock / writeBlock sub-blocks
+
+    DelayLine<float>                   preDelay;
+    int                                preDelayLen = 1;
+
+    SpringDispersion                   dispersion;
+    bool                               chirp = false;
+
+    SpringConvolver                    convolver;     // CONVOLUTION engine
+
+    DelayLine<float, NUM_COMBS>        combs;
+    std::array<int, NUM_COMBS>         combLen   = {};
+    std::array<Vec, COMB_REGISTERS>    combState;     // damping one-poles, lane per comb / line
 
-    std::vector<float>                    preDelayBuf;
-    int                                   preDelayPos = 0;
+    // FDN on the same line bank
+    int                                engine = SCHROEDER;
+    std::array<int, NUM_COMBS>         fdnLen = {};
+    std::array<Vec, COMB_REGISTERS>    fdnGain;       // per-line decay × 1/√N
+    bool                               fdnGainValid = false;
 
-    std::array<std::vector<float>, NUM_COMBS>   combBufs;
-    std::array<int,   NUM_COMBS>                combPos   = {};
-    std::array<float, NUM_COMBS>                combState = {};
+    DelayLine<float, NUM_ALLPASS>      allpasses;
+    std::array<int, NUM_ALLPASS>       apLen = {};
 
-    std::array<std::vector<float>, NUM_ALLPASS> apBufs;
-    std::array<int, NUM_ALLPASS>                apPos = {};
+    SilenceDetector inputSilence, outputSilence;
 
     float roomCoeff = 0.84f;
     float damp      = 0.20f;
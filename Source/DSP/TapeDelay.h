@@ -1,12 +1,41 @@
 #pragma once
 #include <JuceHeader.h>
+#include "SilenceDetector.h"
+#include "HalfbandOversampler.h"
+#include "DelayLine.h"
+#include "ModulationEngine.h"
+#include "Interpolators.h"
+#include "RandomSeed.h"
 #include <vector>
 #include <array>
+#include <algorithm>
 #include <cmath>
+#include <utility>
 
 /**
  *  TapeDelay – Simulates a 3-head tape delay loop (Roland RE-201 style).
  *
+ *  Multi-channel, lockstep: all channels (up to 4, the narrowest SIMD width)
+ *  share one tape transport and are processed together, one SIMD lane each.
+ *   • Tape storage is an interleaved DelayLine (one frame = one sample per
+ *     channel), so an interpolation window is a run of contiguous frames
+ *   • Flutter LFOs, random flutter, motor drift and dropouts are shared —
+ *     only the wow LFO keeps a per-channel phase (stereo spread)
+ *   • LFOs and head-gap coefficients update at control rate (every
+ *     getControlInterval() samples) and are interpolated in between
+ *   • Head reads are batched: the main and print-through positions of every
+ *     head and channel are computed in one vector pass and interpolated
+ *     packed (3 stereo heads: 12 reads in 4 SSE registers instead of 6)
+ *   • Head-gap LP, DC blocker, head bump and crosstalk run once per head
+ *     on a juce::dsp::SIMDRegister
+ *   • Head reads use a selectable interpolator (setInterpolation): linear,
+ *     Catmull-Rom (default), 4th-order Lagrange or 16-tap windowed sinc
+ *   • Tape storage is float, or int16 (compact, half the memory) for long
+ *     loops at high sample rates — reads widen back to float
+ *   • Multi-tap (readTaps): up to MAX_TAPS free-standing heads with their own
+ *     ratio, level and balance, one SIMD lane per head — the read, head-gap
+ *     LP, DC blocker and head bump of 8 taps cost two registers per channel
+ *
  *  v1.5 additions (on top of v1.4):
  *   • Motor drift     — ultra-slow LFO (0.05 Hz), always-on long-term pitch wobble
  *   • Print-through   — ghost echo at delay×0.92 (magnetic bleed from adjacent tape layer)
@@ -20,128 +49,817 @@
  *   • Asymmetric tape saturation — dominant 2nd harmonic
  *   • Catmull-Rom cubic interpolation, DC-removal HP per head, FREEZE support
  */
+template <int NumChannels>
 class TapeDelay
 {
 public:
-    static constexpr int NUM_HEADS = 3;
+    static constexpr int NUM_HEADS    = 3;
+    static constexpr int NUM_CHANNELS = NumChannels;
 
     // Physical head spacing ratios (RE-201 approximation)
     static constexpr std::array<float, 3> HEAD_RATIOS = { 1.0f, 1.475f, 2.625f };
 
-    struct HeadOutputs { std::array<float, NUM_HEADS> heads = {}; };
+    /** Destination buffers: [channel][head] → numSamples floats. */
+    using HeadBuffers = std::array<std::array<float*, NUM_HEADS>, NumChannels>;
+
+    // ── Multi-tap heads ─────────────────────────────────────────────
+    static constexpr int   MAX_TAPS      = 8;
+    static constexpr float MIN_TAP_RATIO = 0.0625f;                 // 1/16 of the base delay
+    static constexpr float MAX_TAP_RATIO = HEAD_RATIOS[NUM_HEADS - 1]; // the tape is sized for it
+
+    /**
+     *  Playback heads for readTaps(): delay as a ratio of the base delay,
+     *  level, and balance (−1 = left only … +1 = right only, stereo tapes).
+     */
+    struct TapPattern
+    {
+        int numTaps = 1;
+        std::array<float, MAX_TAPS> ratio {}, level {}, pan {};
+    };
 
     // ─────────────────────────────────────────────────────────────────
-    void prepare (double newSampleRate, float maxDelayMs = 750.0f, float wowSeedPhase = 0.0f)
+    /**
+     *  @param maxBaseDelayMs  Longest head-1 delay; the tape is sized for head 3
+     *                         at this speed, slowed by worst-case wow/flutter.
+     *  @param wowSeedPhases   Per-channel starting phase of the wow LFO
+     *                         (decorrelates the channels, e.g. { 0, 0.37 }).
+     *  @param maxBlockSize    Longest writeBlock() call.
+     *  @param compactStorage  Store the tape as int16 (see SampleCodec).
+     *  @param seed            RandomSeed for random flutter and dropouts;
+     *                         reset() restarts both from it.
+     */
+    void prepare (double newSampleRate, float maxBaseDelayMs,
+                  const std::array<float, NumChannels>& wowSeedPhases,
+                  int maxBlockSize, bool compactStorage = false, uint32_t seed = 0)
     {
         sampleRate = newSampleRate;
-        bufferSize = static_cast<int> (maxDelayMs / 1000.0 * sampleRate) + 4096;
-        buffer.assign (bufferSize, 0.0f);
-        writePos = 0;
+        randomSeed = seed;
+        SincInterpolator::getTable(); // built here, never on the audio thread
 
-        const float sr = static_cast<float> (sampleRate);
+        maxReadDelay = static_cast<int> (maxBaseDelayMs / 1000.0 * sampleRate
+                                         * HEAD_RATIOS[NUM_HEADS - 1] * MAX_SLOWDOWN)
+                     + SincInterpolator::WIDTH;
 
-        // ── LFO initialisation ──────────────────────────────────────
-        wowPhase      = wowSeedPhase;
-        wowInc        = 0.4f  / sr;
-        flutterPhase  = 0.0f;
-        flutterInc    = 8.0f  / sr;
-        flutter2Phase = 0.37f;
-        flutter2Inc   = 13.7f / sr;
+        // Only the selected storage is allocated
+        compact = compactStorage;
+        tapeLine   .setMaximumDelay (compact ? 0 : maxReadDelay);
+        compactLine.setMaximumDelay (compact ? maxReadDelay : 0);
 
-        // ── Motor drift (very slow long-term speed instability) ─────
-        // 0.05 Hz LFO, ±0.15% pitch — always on, independent of wow/flutter
-        driftPhase = 0.f;
-        driftInc   = 0.05f / sr;
+        recordOversampler.prepare (maxBlockSize);
+        for (auto& ch : recordScratch)
+            ch.assign (static_cast<size_t> (maxBlockSize), 0.f);
 
-        // ── Random flutter state ────────────────────────────────────
-        randState     = 2463534242u;
-        randomFlutter = 0.f;
+        // Until the first read sets the reach: the whole tape
+        silenceReach = maxReadDelay;
+        freezeLoop   = 0;
+        silence.setRequiredRun (maxReadDelay);
+        silence.markSilent();
 
-        // ── Dropout state ───────────────────────────────────────────
-        // Initial blank period of ~2 s before first possible dropout
-        dropRandState = 1234567891u ^ static_cast<uint32_t> (newSampleRate);
-        dropoutTimer  = static_cast<uint32_t> (2.0 * newSampleRate);
-        dropoutLen    = 0u;
-        dropoutGain   = 1.f;
+        const float sr = static_cast<float> (sampleRate);
+
+        // ── Wow / flutter / drift LFOs (control rate) ───────────────
+        modulation.prepare (sampleRate, wowSeedPhases, controlInterval, randomSeed);
 
-        // ── Filter states ───────────────────────────────────────────
-        headLpState.fill (0.f);
-        bumpHiState.fill (0.f);
-        bumpLoState.fill (0.f);
-        hpState.fill     (0.f);
+        // ── Transport: control segments, dropouts, filter states ────
+        resetTransport();
 
         // HP: one-pole at 30 Hz (DC removal)
         hpCoeff = std::exp (-juce::MathConstants<float>::twoPi * 30.f / sr);
 
+        // Head bump LPs (270 Hz / 85 Hz) — fixed per sample rate
+        bumpHiInc = 1.f - std::exp (-juce::MathConstants<float>::twoPi * 270.f / sr);
+        bumpLoInc = 1.f - std::exp (-juce::MathConstants<float>::twoPi *  85.f / sr);
+
         // Reference delay at 150 ms (used for speed-dependent LP scaling)
         refDelaySamples = 0.150f * sr;
     }
 
+    /** Clears the tape and restarts the transport exactly as prepare() left it. */
     void reset()
     {
-        std::fill (buffer.begin(), buffer.end(), 0.f);
-        writePos      = 0;
-        randomFlutter = 0.f;
-        dropoutGain   = 1.f;
-        dropoutLen    = 0u;
-        headLpState.fill (0.f);
-        bumpHiState.fill (0.f);
-        bumpLoState.fill (0.f);
-        hpState.fill     (0.f);
+        tapeLine.clear();
+        compactLine.clear();
+        silence.markSilent();
+        freezeLoop = 0;
+        modulation.reset();
+        recordOversampler.reset();
+        resetTransport();
+    }
+
+    /**
+     *  Samples between control-rate updates of the LFOs and head-gap
+     *  coefficients (1 = every sample).  Takes effect at the next segment.
+     */
+    void setControlInterval (int samples) noexcept
+    {
+        controlInterval = juce::jmax (1, samples);
+        modulation.setControlInterval (controlInterval);
     }
 
-    /** When frozen, the write head stops — the buffer loops infinitely. */
-    void setFrozen (bool shouldFreeze) noexcept { frozen = shouldFreeze; }
+    int getControlInterval() const noexcept { return controlInterval; }
+
+    /** Record-head oversampling: 0 = off, 1 = 2×, 2 = 4×. */
+    void setRecordOversampling (int factorLog2) noexcept
+    {
+        recordOversampler.setFactorLog2 (factorLog2);
+        recordLatency = recordOversampler.getLatencySamples() + externalLatency;
+    }
 
     /**
-     *  Process one sample.
-     *  @param input            Dry input sample
-     *  @param baseDelaySamples Delay in samples for head 1 (others × HEAD_RATIOS)
-     *  @param feedbackSignal   Pre-computed feedback (caller maintains state)
-     *  @param wowFlutterAmt    0..1 — amount of pitch modulation
-     *  @param saturationAmt    0..1 — tape saturation drive
+     *  Delay the caller adds around the tape (e.g. resampling into and out
+     *  of a reduced loop rate), in tape samples.  Taken off every playback
+     *  delay with the record latency, so echoes keep their nominal timing.
      */
-    HeadOutputs process (float input,
-                         float baseDelaySamples,
-                         float feedbackSignal,
-                         float wowFlutterAmt,
-                         float saturationAmt)
+    void setExternalLatency (float samples) noexcept
     {
-        const float sr = static_cast<float> (sampleRate);
+        externalLatency = samples;
+        recordLatency   = recordOversampler.getLatencySamples() + externalLatency;
+    }
+
+    /** Head read quality: 0 = linear, 1 = Catmull-Rom, 2 = Lagrange, 3 = sinc. */
+    void setInterpolation (int quality) noexcept
+    {
+        interpolation = juce::jlimit (0, NUM_INTERPOLATORS - 1, quality);
+    }
+
+    int getInterpolation() const noexcept { return interpolation; }
+
+    bool isCompactStorage() const noexcept { return compact; }
+
+    /** Bytes allocated for the tape itself. */
+    size_t getStorageBytes() const noexcept
+    {
+        return compact ? compactLine.getStorageBytes() : tapeLine.getStorageBytes();
+    }
+
+    static constexpr int NUM_INTERPOLATORS = 4;
+
+    /**
+     *  Heads read by readTaps().  Levels are normalised so they sum to at most
+     *  1 (the loop gain never exceeds the feedback amount).  The next
+     *  readTaps() call glides ratios and gains to the new pattern.
+     */
+    void setTapPattern (const TapPattern& pattern) noexcept
+    {
+        tapTarget = pattern;
+        tapTarget.numTaps = juce::jlimit (1, MAX_TAPS, pattern.numTaps);
+
+        float levelSum = 0.f;
+        for (int k = 0; k < tapTarget.numTaps; ++k)
+        {
+            tapTarget.ratio[(size_t) k] = juce::jlimit (MIN_TAP_RATIO, MAX_TAP_RATIO, pattern.ratio[(size_t) k]);
+            levelSum += juce::jmax (0.f, pattern.level[(size_t) k]);
+        }
+
+        const float norm = 1.f / juce::jmax (1.f, levelSum);
+
+        for (int c = 0; c < NumChannels; ++c)
+        {
+            alignas (Vec::SIMDRegisterSize) float gains[TAP_GROUPS * LANES] = {};
+            for (int k = 0; k < tapTarget.numTaps; ++k)
+            {
+                const float pan = juce::jlimit (-1.f, 1.f, pattern.pan[(size_t) k]);
+                const float balance = NumChannels != 2 ? 1.f
+                                    : c == 0 ? juce::jmin (1.f, 1.f - pan)
+                                             : juce::jmin (1.f, 1.f + pan);
+                gains[k] = juce::jmax (0.f, pattern.level[(size_t) k]) * balance * norm;
+            }
+
+            for (int g = 0; g < TAP_GROUPS; ++g)
+                tapGainTarget[(size_t) c][(size_t) g] = Vec::fromRawArray (gains + g * LANES);
+        }
+
+        tapGapDelay = -1.f; // head-gap filters follow the new ratios
+    }
+
+    /** The pattern readTaps() is heading for (ratios clamped, levels as given). */
+    const TapPattern& getTapPattern() const noexcept { return tapTarget; }
+
+    /** Shortest tap, current (fading ones included) or pending — bounds the
+        block length while taps glide. */
+    float getMinTapRatio() const noexcept
+    {
+        float minRatio = MAX_TAP_RATIO;
+        for (int k = 0; k < tapTarget.numTaps; ++k)
+            minRatio = juce::jmin (minRatio, tapTarget.ratio[(size_t) k]);
+        if (tapsActive)
+            for (int k = 0; k < tapCount; ++k)
+                minRatio = juce::jmin (minRatio, tapRatio[(size_t) k]);
+        return minRatio;
+    }
+
+    /**
+     *  Longest sub-block that can be read before it is written.
+     *
+     *  The shortest tape path is the print-through tap of head 1 (×0.92), pulled
+     *  in a further ~3.2 % by worst-case wow/flutter + drift, minus the record
+     *  latency and the interpolator's look-ahead (2 samples for Catmull-Rom,
+     *  8 for sinc).  Within a block no longer than this, every read lands on
+     *  samples written before the block started.
+     */
+    int getMaxBlockLength (float minBaseDelaySamples) const noexcept
+    {
+        return juce::jmax (1, static_cast<int> (minBaseDelaySamples * 0.89f - recordLatency)
+                                - LOOK_AHEAD[(size_t) interpolation]);
+    }
+
+    /** Bit h set = playback head h is read. */
+    static constexpr unsigned ALL_HEADS = (1u << NUM_HEADS) - 1u;
+
+    /**
+     *  Read the playback heads in HeadMask for every channel over a sub-block
+     *  (record head is not advanced).  Must be followed by writeBlock() or
+     *  skipBlock() with the same numSamples.
+     *
+     *  Heads outside the mask are not evaluated, their headOut buffers are left
+     *  untouched and they contribute no crosstalk.  With an empty mask only the
+     *  transport (wow/flutter, drift, dropouts) advances.
+     *
+     *  Per-sample arguments are indexed [i]: plain arrays, or accessors that
+     *  return a constant for parameters that are not moving.
+     *
+     *  @param headOut          [channel][head] destination buffers
+     *  @param baseDelaySamples Per-sample delay for head 1 (others × HEAD_RATIOS)
+     *  @param wowFlutterAmt    Per-sample 0..1 — amount of pitch modulation
+     *  @param numSamples       ≤ getMaxBlockLength (shortest delay in the block)
+     */
+    template <unsigned HeadMask = ALL_HEADS, typename Delay, typename Amount>
+    void readBlock (const HeadBuffers& headOut,
+                    Delay  baseDelaySamples,
+                    Amount wowFlutterAmt,
+                    int numSamples) noexcept
+    {
+        static_assert ((HeadMask & ~ALL_HEADS) == 0, "invalid head mask");
+
+        tapsActive = false;
+
+        // A head coming back into use starts from a clean filter state
+        if constexpr (HeadMask != 0)
+        {
+            for (int h = 0; h < NUM_HEADS; ++h)
+                if ((HeadMask & ~activeHeads) >> h & 1u)
+                    clearFilterStates (h);
+
+            activeHeads = HeadMask;
+        }
+        else
+        {
+            activeHeads = 0;
+        }
+
+        updateSilenceRun (juce::jmax (baseDelaySamples[0], baseDelaySamples[numSamples - 1]));
+
+        // Transport only — no window is read
+        if constexpr (HeadMask == 0)
+        {
+            readHeadsBlock<0, CatmullRomInterpolator> (tapeLine, headOut, baseDelaySamples, wowFlutterAmt, numSamples);
+        }
+        else
+        {
+            switch (interpolation)
+            {
+                case 0:  readStorage<HeadMask, LinearInterpolator>     (headOut, baseDelaySamples, wowFlutterAmt, numSamples); break;
+                case 2:  readStorage<HeadMask, LagrangeInterpolator>   (headOut, baseDelaySamples, wowFlutterAmt, numSamples); break;
+                case 3:  readStorage<HeadMask, SincInterpolator>       (headOut, baseDelaySamples, wowFlutterAmt, numSamples); break;
+                default: readStorage<HeadMask, CatmullRomInterpolator> (headOut, baseDelaySamples, wowFlutterAmt, numSamples); break;
+            }
+        }
+    }
+
+    /**
+     *  Read the multi-tap heads (setTapPattern) instead of the three fixed
+     *  heads, mixed down to one buffer per channel.  Same contract as
+     *  readBlock(); numSamples ≤ getMaxBlockLength (shortest delay × getMinTapRatio()).
+     *
+     *  Taps have no print-through or crosstalk: they are not physical neighbours.
+     *
+     *  @param out  [channel] destination buffers
+     */
+    template <typename Delay, typename Amount>
+    void readTaps (float* const* out, Delay baseDelaySamples, Amount wowFlutterAmt, int numSamples) noexcept
+    {
+        activeHeads = 0; // the fixed heads restart from a clean state
+
+        updateSilenceRun (juce::jmax (baseDelaySamples[0], baseDelaySamples[numSamples - 1]));
+
+        switch (interpolation)
+        {
+            case 0:  readTapStorage<LinearInterpolator>     (out, baseDelaySamples, wowFlutterAmt, numSamples); break;
+            case 2:  readTapStorage<LagrangeInterpolator>   (out, baseDelaySamples, wowFlutterAmt, numSamples); break;
+            case 3:  readTapStorage<SincInterpolator>       (out, baseDelaySamples, wowFlutterAmt, numSamples); break;
+            default: readTapStorage<CatmullRomInterpolator> (out, baseDelaySamples, wowFlutterAmt, numSamples); break;
+        }
+    }
+
+    /**
+     *  Record a sub-block (input + feedback, already summed by the caller)
+     *  through the saturating record head and advance the tape.
+     *  @param input          Per-channel signal reaching the record head
+     *  @param saturationAmt  Per-sample 0..1 — tape saturation drive
+     */
+    template <typename Amount>
+    void writeBlock (const float* const* input, Amount saturationAmt, int numSamples) noexcept
+    {
+        silence.setRequiredRun (silenceReach);
+        freezeLoop = 0; // recording again: the next freeze takes a new loop
+
+        if (recordOversampler.getFactorLog2() > 0)
+        {
+            writeOversampled (input, saturationAmt, numSamples);
+            return;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            std::array<float, NumChannels> frame;
+            float peak = 0.f;
+            for (int c = 0; c < NumChannels; ++c)
+            {
+                frame[(size_t) c] = saturate (input[c][i], saturationAmt[i]);
+                peak = juce::jmax (peak, std::abs (frame[(size_t) c]));
+            }
+            silence.push (peak);
+            record (frame.data());
+        }
+    }
+
+    /** True once every frame on the tape is below SilenceDetector::THRESHOLD. */
+    bool isSilent() const noexcept { return silence.isSilent(); }
+
+    /**
+     *  Advance the tape without recording (frozen loop): the last freezeLoop
+     *  frames keep cycling, whatever the power-of-two size of the storage.
+     *  The loop is what the heads reached when the freeze began, so every
+     *  head keeps replaying the echoes it was playing.
+     */
+    void skipBlock (int numSamples) noexcept
+    {
+        if (freezeLoop == 0)
+            freezeLoop = silenceReach;
+
+        // Silent once the whole loop has come round below threshold
+        silence.setRequiredRun (juce::jmax (silenceReach, freezeLoop));
+
+        if (compact)
+            loopBack (compactLine, numSamples);
+        else
+            loopBack (tapeLine, numSamples);
+    }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int LANES = static_cast<int> (Vec::SIMDNumElements);
+    static_assert (NumChannels >= 1 && NumChannels <= 4 && NumChannels <= LANES,
+                   "one SIMD register must hold every channel");
+
+    // Frames each interpolator needs past the read point (setInterpolation order)
+    static constexpr std::array<int, NUM_INTERPOLATORS> LOOK_AHEAD =
+    {
+        (LinearInterpolator    ::WIDTH + 1) / 2,
+        (CatmullRomInterpolator::WIDTH + 1) / 2,
+        (LagrangeInterpolator  ::WIDTH + 1) / 2,
+        (SincInterpolator      ::WIDTH + 1) / 2,
+    };
+
+    // Worst-case slow-down by wow/flutter + drift (≈ 3.2 %, rounded up)
+    static constexpr float MAX_SLOWDOWN = 1.04f;
+
+    DelayLine<float,   NumChannels> tapeLine;    // float storage, or …
+    DelayLine<int16_t, NumChannels> compactLine; // … int16 (compact)
+    bool   compact      = false;
+    int    maxReadDelay = 0;    // farthest read, in frames (tape length)
+    int    freezeLoop   = 0;    // FREEZE loop length in frames, 0 = not frozen yet
+    double sampleRate = 44100.0;
+    int    silenceReach = 0;    // frames the heads reach at the current speed
+    unsigned activeHeads = ALL_HEADS; // heads read by the previous readBlock()
+    int      interpolation = 1;       // setInterpolation() — Catmull-Rom
+    SilenceDetector silence;          // frames recorded below threshold
+
+    // Oversampled record head
+    HalfbandOversampler<NumChannels> recordOversampler;
+    std::array<std::vector<float>, NumChannels> recordScratch;
+    float recordLatency   = 0.f;      // samples, taken off every playback delay
+    float externalLatency = 0.f;      // setExternalLatency(), part of recordLatency
+
+    // Wow / flutter / drift — wow is per channel, the rest is shared by the transport
+    ModulationEngine<NumChannels> modulation;
+    int controlInterval  = ModulationEngine<NumChannels>::DEFAULT_CONTROL_INTERVAL;
+    int controlCountdown = 0; // samples left in the current control segment
+
+    // Dropout state
+    uint32_t randomSeed    = 0;            // prepare()'s RandomSeed
+    uint32_t dropRandState = 1234567891u;
+    uint32_t dropoutTimer  = 88200u;   // samples until next dropout event
+    uint32_t dropoutLen    = 0u;       // samples remaining in current dropout
+    float    dropoutGain   = 1.f;      // current playback amplitude (1 = no dropout)
+
+    // Per-head filter states, one lane per channel
+    std::array<Vec, NUM_HEADS> headLpState; // head-gap LP
+    std::array<Vec, NUM_HEADS> bumpHiState; // head bump LP hi
+    std::array<Vec, NUM_HEADS> bumpLoState; // head bump LP lo
+    std::array<Vec, NUM_HEADS> hpState;     // DC removal HP
+
+    float hpCoeff         = 0.999f;
+    float bumpHiInc       = 0.f;
+    float bumpLoInc       = 0.f;
+    float refDelaySamples = 6615.f; // 150 ms @ 44100 Hz
+
+    // Head-gap LP coefficients, ramping by headGapStep per sample towards
+    // headGapTarget (the tape speed gapDelaySamples) over a control segment
+    std::array<float, NUM_HEADS> headGapCoeff  = {};
+    std::array<float, NUM_HEADS> headGapStep   = {};
+    std::array<float, NUM_HEADS> headGapTarget = {};
+    float gapDelaySamples = -1.f;
+
+    // Multi-tap bank: lane j of group g is tap g × LANES + j.  Ratios, gains
+    // and head-gap coefficients glide to their targets over one readTaps()
+    static constexpr int TAP_GROUPS = (MAX_TAPS + LANES - 1) / LANES;
+    using TapVecs = std::array<Vec, TAP_GROUPS>;
 
-        // ── 1. Organic wow & flutter ──────────────────────────────────
+    TapPattern tapTarget;
+    std::array<float, MAX_TAPS> tapRatio {}, tapRatioStep {};
+    std::array<TapVecs, NumChannels> tapGain {}, tapGainStep {}, tapGainTarget {};
+    TapVecs tapGapCoeff {}, tapGapStep {}, tapGapTarget {};
+    float tapGapDelay = -1.f;  // base delay of tapGapTarget (−1 = recompute)
+    int   tapCount    = 0;     // taps read by the previous readTaps()
+    bool  tapsActive  = false; // previous read was readTaps()
 
-        const float wow  = std::sin (wowPhase  * juce::MathConstants<float>::twoPi);
-        advancePhase (wowPhase, wowInc);
+    // Per-tap filter states, [channel][group]
+    std::array<TapVecs, NumChannels> tapLpState, tapHpState, tapBumpHiState, tapBumpLoState;
+
+    // ─────────────────────────────────────────────────────────────────
+    void resetTransport() noexcept
+    {
+        controlCountdown = 0; // first sample starts a control segment
+
+        // Initial blank period of ~2 s before first possible dropout
+        dropRandState = RandomSeed::derive (1234567891u ^ static_cast<uint32_t> (sampleRate), randomSeed);
+        dropoutTimer  = static_cast<uint32_t> (2.0 * sampleRate);
+        dropoutLen    = 0u;
+        dropoutGain   = 1.f;
+
+        gapDelaySamples = -1.f; // force coefficient update
+        headGapStep.fill (0.f);
+
+        clearFilterStates();
+    }
 
-        const float flt1 = std::sin (flutterPhase  * juce::MathConstants<float>::twoPi);
-        advancePhase (flutterPhase, flutterInc);
+    void clearFilterStates() noexcept
+    {
+        for (int h = 0; h < NUM_HEADS; ++h)
+            clearFilterStates (h);
 
-        const float flt2 = std::sin (flutter2Phase * juce::MathConstants<float>::twoPi);
-        advancePhase (flutter2Phase, flutter2Inc);
+        tapsActive = false;
+    }
 
-        // xorshift32 noise → LP-filtered to ~5 Hz → organic random flutter
-        randState ^= randState << 13;
-        randState ^= randState >> 17;
-        randState ^= randState << 5;
-        const float rNoise = static_cast<float> (static_cast<int32_t> (randState)) * 4.656e-10f;
-        randomFlutter += 0.000713f * (rNoise - randomFlutter); // LP ≈ 5 Hz at 44100
+    void clearFilterStates (int h) noexcept
+    {
+        headLpState[(size_t) h] = Vec::expand (0.f);
+        bumpHiState[(size_t) h] = Vec::expand (0.f);
+        bumpLoState[(size_t) h] = Vec::expand (0.f);
+        hpState    [(size_t) h] = Vec::expand (0.f);
+    }
 
-        const float mod = (wow  * 0.0042f          // 0.4 Hz wow
-                         + flt1 * 0.0009f          // 8 Hz flutter
-                         + flt2 * 0.0002f          // 13.7 Hz flutter
-                         + randomFlutter * 0.025f) // organic random component
-                        * wowFlutterAmt;
+    // ─────────────────────────────────────────────────────────────────
+    // Record head at 2×/4×: saturate between the half-band filters
+    template <typename Amount>
+    void writeOversampled (const float* const* input, Amount saturationAmt, int numSamples) noexcept
+    {
+        std::array<float*, NumChannels> io;
+        for (int c = 0; c < NumChannels; ++c)
+        {
+            io[(size_t) c] = recordScratch[(size_t) c].data();
+            std::copy_n (input[c], numSamples, io[(size_t) c]);
+        }
 
-        // ── 2. Motor drift — ultra-slow LFO (always-on) ───────────────
-        // 0.05 Hz, ±0.15% pitch — simulates motor speed instability
-        const float drift = std::sin (driftPhase * juce::MathConstants<float>::twoPi) * 0.0015f;
-        advancePhase (driftPhase, driftInc);
+        const int shift = recordOversampler.getFactorLog2();
+        recordOversampler.process (io.data(), numSamples, [&] (float* const* up, int numUp)
+        {
+            for (int c = 0; c < NumChannels; ++c)
+                for (int j = 0; j < numUp; ++j)
+                    up[c][j] = saturate (up[c][j], saturationAmt[j >> shift]);
+        });
 
-        const float totalMod = mod + drift;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            std::array<float, NumChannels> frame;
+            float peak = 0.f;
+            for (int c = 0; c < NumChannels; ++c)
+            {
+                frame[(size_t) c] = io[(size_t) c][i];
+                peak = juce::jmax (peak, std::abs (frame[(size_t) c]));
+            }
+            silence.push (peak);
+            record (frame.data());
+        }
+    }
 
-        // ── 3. Dropout simulation ──────────────────────────────────────
-        // Rare amplitude dips (~2–3/min) simulating worn tape oxide
+    // ─────────────────────────────────────────────────────────────────
+    // Record head → tape, in the storage format
+    void record (const float* frame) noexcept
+    {
+        if (compact)
+        {
+            std::array<int16_t, NumChannels> q;
+            for (int c = 0; c < NumChannels; ++c)
+                SampleCodec::encode (frame[c], q[(size_t) c]);
+            compactLine.push (q.data());
+        }
+        else
+        {
+            tapeLine.push (frame);
+        }
+    }
+
+    template <typename Line>
+    void loopBack (Line& line, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto* frame = line.frame (line.getWritePos() - freezeLoop);
+            float peak = 0.f;
+            for (int c = 0; c < NumChannels; ++c)
+                peak = juce::jmax (peak, std::abs (SampleCodec::decode (frame[c])));
+
+            silence.push (peak);
+            line.push (frame);
+        }
+    }
+
+    // The tape is silent once everything the heads can reach at this speed
+    // was re-recorded below threshold (writeBlock / skipBlock apply it)
+    void updateSilenceRun (float baseDelaySamples) noexcept
+    {
+        silenceReach = juce::jmin (maxReadDelay,
+                                   static_cast<int> (baseDelaySamples * HEAD_RATIOS[NUM_HEADS - 1] * MAX_SLOWDOWN)
+                                       + SincInterpolator::WIDTH);
+    }
+
+    // ─────────────────────────────────────────────────────────────────
+    // readBlock() body for one interpolator, on the active storage
+    template <unsigned HeadMask, typename Interp, typename Delay, typename Amount>
+    void readStorage (const HeadBuffers& headOut, Delay baseDelaySamples,
+                      Amount wowFlutterAmt, int numSamples) noexcept
+    {
+        if (compact)
+            readHeadsBlock<HeadMask, Interp> (compactLine, headOut, baseDelaySamples, wowFlutterAmt, numSamples);
+        else
+            readHeadsBlock<HeadMask, Interp> (tapeLine, headOut, baseDelaySamples, wowFlutterAmt, numSamples);
+    }
+
+    template <unsigned HeadMask, typename Interp, typename Line, typename Delay, typename Amount>
+    void readHeadsBlock (const Line& line, const HeadBuffers& headOut, Delay baseDelaySamples,
+                         Amount wowFlutterAmt, int numSamples) noexcept
+    {
+        // Gather scratch, one window per batch register (unused lanes stay zero)
+        std::array<typename Interp::Window, ReadBatch<HeadMask>::REGISTERS> windows;
+
+        alignas (Vec::SIMDRegisterSize) float lanes[LANES] = {};
+        int readPos = line.getWritePos();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto totalMod = advanceTransport (i, baseDelaySamples, wowFlutterAmt, numSamples);
+
+            if constexpr (HeadMask != 0)
+            {
+                const auto heads = readHeads<HeadMask, Interp> (line, readPos, baseDelaySamples[i], totalMod,
+                                                                windows);
+                for (int h = 0; h < NUM_HEADS; ++h)
+                {
+                    if (! (HeadMask >> h & 1u))
+                        continue;
+
+                    heads[(size_t) h].copyToRawArray (lanes);
+                    for (int c = 0; c < NumChannels; ++c)
+                        headOut[(size_t) c][(size_t) h][i] = lanes[c];
+                }
+
+                ++readPos;
+            }
+
+            for (int h = 0; h < NUM_HEADS; ++h)
+                headGapCoeff[(size_t) h] += headGapStep[(size_t) h];
+        }
+    }
+
+    // ─────────────────────────────────────────────────────────────────
+    // readTaps() body for one interpolator, on the active storage
+    template <typename Interp, typename Delay, typename Amount>
+    void readTapStorage (float* const* out, Delay baseDelaySamples,
+                         Amount wowFlutterAmt, int numSamples) noexcept
+    {
+        if (compact)
+            readTapsBlock<Interp> (compactLine, out, baseDelaySamples, wowFlutterAmt, numSamples);
+        else
+            readTapsBlock<Interp> (tapeLine, out, baseDelaySamples, wowFlutterAmt, numSamples);
+    }
+
+    template <typename Interp, typename Line, typename Delay, typename Amount>
+    void readTapsBlock (const Line& line, float* const* out, Delay baseDelaySamples,
+                        Amount wowFlutterAmt, int numSamples) noexcept
+    {
+        const int numTaps   = beginTapSegment (baseDelaySamples[numSamples - 1], numSamples);
+        const int numGroups = (numTaps + LANES - 1) / LANES;
+        const float maxDelay = static_cast<float> (maxReadDelay - SincInterpolator::WIDTH);
+
+        // Filter states live in registers for the block
+        auto lpStates     = tapLpState;
+        auto hpStates     = tapHpState;
+        auto bumpHiStates = tapBumpHiState;
+        auto bumpLoStates = tapBumpLoState;
+
+        const Vec hpc  = Vec::expand (hpCoeff);
+        const Vec hpc1 = Vec::expand (1.f - hpCoeff);
+        const Vec one  = Vec::expand (1.f);
+
+        typename Interp::Window window;
+        int readPos = line.getWritePos();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto totalMod = advanceTransport (i, baseDelaySamples, wowFlutterAmt, numSamples);
+
+            for (int c = 0; c < NumChannels; ++c)
+            {
+                const float speed = baseDelaySamples[i] * (1.f + totalMod[(size_t) c]);
+                Vec mix = Vec::expand (0.f);
+
+                for (int g = 0; g < numGroups; ++g)
+                {
+                    // Spare lanes of the last group repeat its last tap at zero gain
+                    for (int j = 0; j < LANES; ++j)
+                    {
+                        const int k = juce::jmin (g * LANES + j, numTaps - 1);
+                        const float delay = juce::jlimit (1.f, maxDelay, speed * tapRatio[(size_t) k]);
+                        gather<Interp> (line, window, j, c, readPos,
+                                        juce::jlimit (1.f, maxDelay, delay - recordLatency));
+                    }
+
+                    Vec raw = Interp::template interpolate<LANES> (window) * dropoutGain;
+
+                    // Head-gap LP, DC removal, head bump — as the fixed heads
+                    auto& lp = lpStates[(size_t) c][(size_t) g];
+                    lp  = tapGapCoeff[(size_t) g] * lp + (one - tapGapCoeff[(size_t) g]) * raw;
+                    raw = lp;
+
+                    auto& hp = hpStates[(size_t) c][(size_t) g];
+                    const Vec y = raw - hp;
+                    hp  = hpc * hp + hpc1 * raw;
+                    raw = y;
+
+                    auto& bumpHi = bumpHiStates[(size_t) c][(size_t) g];
+                    auto& bumpLo = bumpLoStates[(size_t) c][(size_t) g];
+                    bumpHi += (raw - bumpHi) * bumpHiInc;
+                    bumpLo += (raw - bumpLo) * bumpLoInc;
+                    raw += (bumpHi - bumpLo) * 0.28f;
+
+                    mix += raw * tapGain[(size_t) c][(size_t) g];
+                    tapGain[(size_t) c][(size_t) g] += tapGainStep[(size_t) c][(size_t) g];
+                }
+
+                out[c][i] = mix.sum();
+            }
+
+            for (int k = 0; k < numTaps; ++k)
+                tapRatio[(size_t) k] += tapRatioStep[(size_t) k];
+            for (int g = 0; g < numGroups; ++g)
+                tapGapCoeff[(size_t) g] += tapGapStep[(size_t) g];
+
+            for (int h = 0; h < NUM_HEADS; ++h)
+                headGapCoeff[(size_t) h] += headGapStep[(size_t) h];
+
+            ++readPos;
+        }
+
+        tapLpState     = lpStates;
+        tapHpState     = hpStates;
+        tapBumpHiState = bumpHiStates;
+        tapBumpLoState = bumpLoStates;
+
+        endTapSegment();
+    }
+
+    // Start a glide to tapTarget over numSamples; returns the taps to read
+    int beginTapSegment (float baseDelaySamples, int numSamples) noexcept
+    {
+        const int target = tapTarget.numTaps;
+
+        if (! tapsActive)
+        {
+            // Taps (re)starting: no glide, clean filters
+            tapRatio    = tapTarget.ratio;
+            tapGain     = tapGainTarget;
+            tapCount    = target;
+            tapGapDelay = -1.f;
+            clearTapStates (0);
+        }
+        else if (target > tapCount)
+        {
+            // New taps start at their position, from silence
+            for (int k = tapCount; k < target; ++k)
+                tapRatio[(size_t) k] = tapTarget.ratio[(size_t) k];
+            clearTapStates (tapCount);
+        }
+
+        const int numTaps = juce::jmax (tapCount, target);
+        const float inv   = 1.f / static_cast<float> (numSamples);
+
+        // Taps being removed fade out where they are (their target ratio is unused)
+        for (int k = 0; k < numTaps; ++k)
+            tapRatioStep[(size_t) k] = k < target ? (tapTarget.ratio[(size_t) k] - tapRatio[(size_t) k]) * inv
+                                                  : 0.f;
+
+        for (int c = 0; c < NumChannels; ++c)
+            for (int g = 0; g < TAP_GROUPS; ++g)
+                tapGainStep[(size_t) c][(size_t) g] = (tapGainTarget[(size_t) c][(size_t) g]
+                                                       - tapGain[(size_t) c][(size_t) g]) * inv;
+
+        // Head-gap cutoff falls with the tap's distance, through the fixed
+        // heads' 7000 / 5200 / 3800 Hz at ratios 1 / 1.475 / 2.625
+        const bool first = tapGapDelay < 0.f && ! tapsActive;
+        if (baseDelaySamples != tapGapDelay)
+        {
+            const float sr = static_cast<float> (sampleRate);
+            const float speedRatio = refDelaySamples / juce::jmax (1.f, baseDelaySamples);
+
+            alignas (Vec::SIMDRegisterSize) float coeffs[TAP_GROUPS * LANES] = {};
+            for (int k = 0; k < TAP_GROUPS * LANES; ++k)
+            {
+                const float ratio = tapTarget.ratio[(size_t) juce::jmin (k, target - 1)];
+                const float fc = juce::jlimit (1800.f, 9000.f, 7000.f * std::pow (ratio, -0.7f) * speedRatio);
+                coeffs[k] = std::exp (-juce::MathConstants<float>::twoPi * fc / sr);
+            }
+
+            for (int g = 0; g < TAP_GROUPS; ++g)
+                tapGapTarget[(size_t) g] = Vec::fromRawArray (coeffs + g * LANES);
+
+            tapGapDelay = baseDelaySamples;
+        }
+
+        if (first)
+            tapGapCoeff = tapGapTarget;
+
+        for (int g = 0; g < TAP_GROUPS; ++g)
+            tapGapStep[(size_t) g] = (tapGapTarget[(size_t) g] - tapGapCoeff[(size_t) g]) * inv;
+
+        tapsActive = true;
+        return numTaps;
+    }
+
+    // Land exactly on the targets — no accumulated rounding
+    void endTapSegment() noexcept
+    {
+        tapRatio    = tapTarget.ratio;
+        tapGain     = tapGainTarget;
+        tapGapCoeff = tapGapTarget;
+        tapCount    = tapTarget.numTaps;
+    }
+
+    // Zero the filter states of taps firstTap … MAX_TAPS − 1
+    void clearTapStates (int firstTap) noexcept
+    {
+        for (auto* states : { &tapLpState, &tapHpState, &tapBumpHiState, &tapBumpLoState })
+        {
+            for (auto& channel : *states)
+            {
+                for (int g = 0; g < TAP_GROUPS; ++g)
+                {
+                    alignas (Vec::SIMDRegisterSize) float lanes[LANES];
+                    channel[(size_t) g].copyToRawArray (lanes);
+                    for (int j = 0; j < LANES; ++j)
+                        if (g * LANES + j >= firstTap)
+                            lanes[j] = 0.f;
+                    channel[(size_t) g] = Vec::fromRawArray (lanes);
+                }
+            }
+        }
+    }
+
+    // ─────────────────────────────────────────────────────────────────
+    // Transport for sample i: control-rate segments, wow/flutter, dropouts
+    template <typename Delay, typename Amount>
+    std::array<float, NumChannels> advanceTransport (int i, Delay baseDelaySamples, Amount wowFlutterAmt,
+                                                     int numSamples) noexcept
+    {
+        if (controlCountdown == 0)
+        {
+            // Coefficients ramp towards the tape speed at the end of the segment
+            modulation.beginSegment();
+            beginHeadGapSegment (baseDelaySamples[juce::jmin (i + controlInterval, numSamples) - 1]);
+            controlCountdown = controlInterval;
+        }
+        --controlCountdown;
+
+        const auto totalMod = modulation.next (wowFlutterAmt[i]);
+        advanceDropout();
+        return totalMod;
+    }
+
+    // ─────────────────────────────────────────────────────────────────
+    // Dropout simulation — rare amplitude dips (~2–3/min), worn tape oxide
+    void advanceDropout() noexcept
+    {
         if (dropoutLen > 0)
         {
             // Gradual recovery: time constant ≈ 250 samples (~5.7 ms @ 44.1 kHz)
@@ -165,146 +883,226 @@ public:
             dropRandState ^= dropRandState << 13;
             dropRandState ^= dropRandState >> 17;
             dropRandState ^= dropRandState << 5;
-            dropoutTimer = static_cast<uint32_t> (sr * 15.f) + (dropRandState & 0xFFFFFu);
+            dropoutTimer = static_cast<uint32_t> (static_cast<float> (sampleRate) * 15.f)
+                         + (dropRandState & 0xFFFFFu);
         }
         else
         {
             --dropoutTimer;
         }
+    }
+
+    // ─────────────────────────────────────────────────────────────────
+    // Batched head reads: every read of one sample — main and print-through
+    // of each head in HeadMask, for every channel — packed into registers.
+    // Read r of the main half sits in lane r (head-major, channel-minor);
+    // the print-through half repeats that layout REGISTERS / 2 registers on.
+    static constexpr int countHeads (unsigned headMask) noexcept
+    {
+        int n = 0;
+        for (int h = 0; h < NUM_HEADS; ++h)
+            if (headMask >> h & 1u) ++n;
+        return n;
+    }
 
-        // ── 4. Write (record head) — asymmetric tape saturation ────────
-        float toWrite = saturate (input + feedbackSignal, saturationAmt);
-        if (! frozen)
-            buffer[writePos] = toWrite;
+    template <int Size>
+    struct alignas (Vec::SIMDRegisterSize) LaneConstants { float lane[Size]; };
 
-        // ── 5. Read (playback heads) + per-head processing ─────────────
-        const float speedRatio = refDelaySamples / juce::jmax (1.f, baseDelaySamples);
+    // Head ratio of every main-half lane (spare lanes repeat the last read)
+    template <unsigned HeadMask, int Size>
+    static constexpr LaneConstants<Size> makeReadRatios() noexcept
+    {
+        LaneConstants<Size> r {};
+        int read = 0;
+        for (int h = 0; h < NUM_HEADS; ++h)
+            if (HeadMask >> h & 1u)
+                for (int c = 0; c < NumChannels; ++c)
+                    r.lane[read++] = HEAD_RATIOS[(size_t) h];
+        for (; read < Size; ++read)
+            r.lane[read] = read > 0 ? r.lane[read - 1] : 1.f;
+        return r;
+    }
 
-        // Base head-gap cutoff frequencies at reference speed (150 ms)
-        static constexpr float HEAD_BASE_FC[NUM_HEADS] = { 7000.f, 5200.f, 3800.f };
+    template <unsigned HeadMask>
+    struct ReadBatch
+    {
+        static constexpr int READS     = countHeads (HeadMask) * NumChannels; // per half
+        static constexpr int HALF      = std::max (1, (READS + LANES - 1) / LANES);
+        static constexpr int REGISTERS = 2 * HALF;
 
-        const float bumpHiInc = 1.f - std::exp (-juce::MathConstants<float>::twoPi * 270.f / sr);
-        const float bumpLoInc = 1.f - std::exp (-juce::MathConstants<float>::twoPi *  85.f / sr);
+        static constexpr auto RATIOS = makeReadRatios<HeadMask, HALF * LANES>();
 
-        HeadOutputs out;
-        for (int h = 0; h < NUM_HEADS; ++h)
+        /** Lanes of register g that hold a read (interpolate<> only evaluates those). */
+        static constexpr int lanesIn (int g) noexcept
         {
-            // a) Catmull-Rom read with combined modulation (wow/flutter + motor drift)
-            float delay = baseDelaySamples * HEAD_RATIOS[h] * (1.f + totalMod);
-            delay = juce::jlimit (1.f, static_cast<float> (bufferSize - 4), delay);
-            float raw = readCubic (delay);
+            return std::clamp (READS - (g % HALF) * LANES, 0, LANES);
+        }
+    };
+
+    // Evaluate every batch register with its exact lane count
+    template <typename Batch, typename Interp, typename Windows, size_t... G>
+    static void interpolateBatch (const Windows& windows, Vec* out, std::index_sequence<G...>) noexcept
+    {
+        ((out[G] = Interp::template interpolate<Batch::lanesIn (static_cast<int> (G))> (windows[G])), ...);
+    }
+
+    // ─────────────────────────────────────────────────────────────────
+    // Playback heads in HeadMask at record position readPos + per-head processing
+    template <unsigned HeadMask, typename Interp, typename Line>
+    std::array<Vec, NUM_HEADS> readHeads (const Line& line, int readPos, float baseDelaySamples,
+                                          const std::array<float, NumChannels>& totalMod,
+                                          std::array<typename Interp::Window, ReadBatch<HeadMask>::REGISTERS>& windows) noexcept
+    {
+        using Batch = ReadBatch<HeadMask>;
+        constexpr int HALF = Batch::HALF;
 
-            // b) Dropout — tape oxide wear affects playback amplitude
-            raw *= dropoutGain;
+        const float maxDelay = static_cast<float> (maxReadDelay - SincInterpolator::WIDTH);
 
-            // c) Print-through — faint ghost echo at 92% of the main delay
-            //    Magnetic bleed from adjacent tape layers creates a subtle pre-echo
-            //    ~35 dB below the main signal (≈ gain 0.018)
+        // a) Every read position in one vector pass: combined modulation
+        //    (wow/flutter + motor drift), then c) print-through — faint ghost
+        //    echo at 92% of the main delay.  Magnetic bleed from adjacent tape
+        //    layers creates a subtle pre-echo ~35 dB below the main signal
+        //    (≈ gain 0.018).  Record latency comes off both — echoes keep
+        //    their nominal timing.
+        alignas (Vec::SIMDRegisterSize) float mod[LANES];
+        alignas (Vec::SIMDRegisterSize) float reads[2 * HALF * LANES];
+        {
+            const Vec lo   = Vec::expand (1.f);
+            const Vec hi   = Vec::expand (maxDelay);
+            const Vec lat  = Vec::expand (recordLatency);
+            const Vec base = Vec::expand (baseDelaySamples);
+
+            for (int g = 0; g < HALF; ++g)
             {
-                const float ptDelay = juce::jlimit (1.f, static_cast<float> (bufferSize - 4),
-                                                    delay * 0.92f);
-                raw += readCubic (ptDelay) * 0.018f;
+                for (int j = 0; j < LANES; ++j)
+                    mod[j] = 1.f + totalMod[(size_t) ((g * LANES + j) % NumChannels)];
+
+                const Vec ratio = Vec::fromRawArray (Batch::RATIOS.lane + g * LANES);
+                const Vec delay = Vec::min (hi, Vec::max (lo, base * ratio * Vec::fromRawArray (mod)));
+
+                Vec::min (hi, Vec::max (lo, delay - lat))         .copyToRawArray (reads + g * LANES);
+                Vec::min (hi, Vec::max (lo, delay * 0.92f - lat)) .copyToRawArray (reads + (HALF + g) * LANES);
+            }
+        }
+
+        // Fetch every window, then evaluate all of them register by register
+        for (int half = 0; half < 2; ++half)
+            for (int r = 0; r < Batch::READS; ++r)
+                gather<Interp> (line, windows[(size_t) (half * HALF + r / LANES)], r % LANES,
+                                r % NumChannels, readPos, reads[half * HALF * LANES + r]);
+
+        std::array<Vec, Batch::REGISTERS> interpolated;
+        interpolateBatch<Batch, Interp> (windows, interpolated.data(), std::make_index_sequence<Batch::REGISTERS> {});
+
+        // b) Dropout — tape oxide wear affects playback amplitude
+        alignas (Vec::SIMDRegisterSize) float mixed[HALF * LANES];
+        for (int g = 0; g < HALF; ++g)
+            (interpolated[(size_t) g] * dropoutGain + interpolated[(size_t) (HALF + g)] * 0.018f)
+                .copyToRawArray (mixed + g * LANES);
+
+        std::array<Vec, NUM_HEADS> heads;
+        alignas (Vec::SIMDRegisterSize) float lanes[LANES] = {};
+        int read = 0;
+
+        for (int h = 0; h < NUM_HEADS; ++h)
+        {
+            if (! (HeadMask >> h & 1u))
+            {
+                heads[(size_t) h] = Vec::expand (0.f);
+                continue;
             }
 
+            // Back to one lane per channel for the per-head filters
+            std::copy_n (mixed + read, NumChannels, lanes);
+            read += NumChannels;
+            Vec raw = Vec::fromRawArray (lanes);
+
             // d) Head-gap loss LP — speed-dependent + per-head darkening
-            const float fc  = juce::jlimit (1800.f, 9000.f, HEAD_BASE_FC[h] * speedRatio);
-            const float lpc = std::exp (-juce::MathConstants<float>::twoPi * fc / sr);
-            headLpState[h]  = lpc * headLpState[h] + (1.f - lpc) * raw;
-            raw = headLpState[h];
+            const float lpc = headGapCoeff[(size_t) h];
+            auto& lp = headLpState[(size_t) h];
+            lp  = Vec::expand (lpc) * lp + Vec::expand (1.f - lpc) * raw;
+            raw = lp;
 
             // e) DC removal (one-pole HP at 30 Hz)
             {
-                const float y = raw - hpState[h];
-                hpState[h] = hpCoeff * hpState[h] + (1.f - hpCoeff) * raw;
+                auto& hp = hpState[(size_t) h];
+                const Vec y = raw - hp;
+                hp  = Vec::expand (hpCoeff) * hp + Vec::expand (1.f - hpCoeff) * raw;
                 raw = y;
             }
 
             // f) Head bump: bandpass around 150 Hz → warm low-mid presence
-            bumpHiState[h] += bumpHiInc * (raw - bumpHiState[h]); // LP at 270 Hz
-            bumpLoState[h] += bumpLoInc * (raw - bumpLoState[h]); // LP at  85 Hz
-            raw += (bumpHiState[h] - bumpLoState[h]) * 0.28f;     // +bandpass mix
+            auto& bumpHi = bumpHiState[(size_t) h];
+            auto& bumpLo = bumpLoState[(size_t) h];
+            bumpHi += (raw - bumpHi) * bumpHiInc;    // LP at 270 Hz
+            bumpLo += (raw - bumpLo) * bumpLoInc;    // LP at  85 Hz
+            raw += (bumpHi - bumpLo) * 0.28f;        // +bandpass mix
 
-            out.heads[h] = raw;
+            heads[(size_t) h] = raw;
         }
 
-        // ── 6. Inter-head crosstalk — 1.5% adjacent-head bleed ─────────
+        // ── Inter-head crosstalk — 1.5% adjacent-head bleed ───────────
         // Simulates magnetic cross-talk between physically adjacent record/play heads
+        // (only heads that are being read take part)
         {
-            const std::array<float, NUM_HEADS> orig = out.heads;
+            const std::array<Vec, NUM_HEADS> orig = heads;
             for (int h = 0; h < NUM_HEADS; ++h)
             {
-                if (h > 0)             out.heads[h] += orig[h - 1] * 0.015f;
-                if (h < NUM_HEADS - 1) out.heads[h] += orig[h + 1] * 0.015f;
+                if (! (HeadMask >> h & 1u))
+                    continue;
+
+                if (h > 0             && (HeadMask >> (h - 1) & 1u)) heads[(size_t) h] += orig[(size_t) h - 1] * 0.015f;
+                if (h < NUM_HEADS - 1 && (HeadMask >> (h + 1) & 1u)) heads[(size_t) h] += orig[(size_t) h + 1] * 0.015f;
             }
         }
 
-        if (++writePos >= bufferSize) writePos = 0;
-        return out;
+        return heads;
     }
 
-private:
-    std::vector<float> buffer;
-    int    bufferSize = 0;
-    int    writePos   = 0;
-    double sampleRate = 44100.0;
-    bool   frozen     = false;
+    // ─────────────────────────────────────────────────────────────────
+    // Head-gap coefficients: one std::exp per head per control segment, and
+    // only while the tape speed moves — linear ramp in between
+    void beginHeadGapSegment (float baseDelaySamples) noexcept
+    {
+        // Base head-gap cutoff frequencies at reference speed (150 ms)
+        static constexpr float HEAD_BASE_FC[NUM_HEADS] = { 7000.f, 5200.f, 3800.f };
 
-    // LFO
-    float wowPhase = 0.f,      wowInc       = 0.f;
-    float flutterPhase = 0.f,  flutterInc   = 0.f;
-    float flutter2Phase = 0.f, flutter2Inc  = 0.f;
+        const bool first = gapDelaySamples < 0.f;
 
-    // Motor drift (ultra-slow, always-on)
-    float driftPhase = 0.f,    driftInc     = 0.f;
+        // Land exactly on the previous target — no accumulated rounding
+        headGapCoeff = headGapTarget;
+        headGapStep.fill (0.f);
 
-    // Organic flutter noise
-    uint32_t randState     = 2463534242u;
-    float    randomFlutter = 0.f;
+        if (baseDelaySamples == gapDelaySamples)
+            return;
 
-    // Dropout state
-    uint32_t dropRandState = 1234567891u;
-    uint32_t dropoutTimer  = 88200u;   // samples until next dropout event
-    uint32_t dropoutLen    = 0u;       // samples remaining in current dropout
-    float    dropoutGain   = 1.f;      // current playback amplitude (1 = no dropout)
+        const float sr = static_cast<float> (sampleRate);
+        const float speedRatio = refDelaySamples / juce::jmax (1.f, baseDelaySamples);
 
-    // Per-head filter states
-    std::array<float, NUM_HEADS> headLpState = {}; // head-gap LP
-    std::array<float, NUM_HEADS> bumpHiState = {}; // head bump LP hi
-    std::array<float, NUM_HEADS> bumpLoState = {}; // head bump LP lo
-    std::array<float, NUM_HEADS> hpState     = {}; // DC removal HP
+        for (int h = 0; h < NUM_HEADS; ++h)
+        {
+            const float fc = juce::jlimit (1800.f, 9000.f, HEAD_BASE_FC[h] * speedRatio);
+            headGapTarget[(size_t) h] = std::exp (-juce::MathConstants<float>::twoPi * fc / sr);
+        }
 
-    float hpCoeff         = 0.999f;
-    float refDelaySamples = 6615.f; // 150 ms @ 44100 Hz
+        if (first)
+            headGapCoeff = headGapTarget;
+        else
+            for (int h = 0; h < NUM_HEADS; ++h)
+                headGapStep[(size_t) h] = (headGapTarget[(size_t) h] - headGapCoeff[(size_t) h])
+                                        / static_cast<float> (controlInterval);
 
-    // ─────────────────────────────────────────────────────────────────
-    static void advancePhase (float& ph, float inc) noexcept
-    {
-        ph += inc;
-        if (ph >= 1.f) ph -= 1.f;
+        gapDelaySamples = baseDelaySamples;
     }
 
     // ─────────────────────────────────────────────────────────────────
-    // Catmull-Rom cubic interpolation
-    float readCubic (float delaySamples) const noexcept
+    // Fetch the interpolation window of channel c into a lane
+    template <typename Interp, typename Line>
+    static void gather (const Line& line, typename Interp::Window& window,
+                        int lane, int c, int readPos, float delaySamples) noexcept
     {
-        float rPos = static_cast<float> (writePos) - delaySamples;
-        while (rPos < 0.f) rPos += static_cast<float> (bufferSize);
-
-        const int i1 = static_cast<int> (rPos) % bufferSize;
-        const float t = rPos - std::floor (rPos);
-
-        const int im1 = (i1 - 1 + bufferSize) % bufferSize;
-        const int  i2 = (i1 + 1) % bufferSize;
-        const int  i3 = (i1 + 2) % bufferSize;
-
-        const float y0 = buffer[im1], y1 = buffer[i1];
-        const float y2 = buffer[i2],  y3 = buffer[i3];
-
-        const float a0 = -0.5f*y0 + 1.5f*y1 - 1.5f*y2 + 0.5f*y3;
-        const float a1 =        y0 - 2.5f*y1 + 2.0f*y2 - 0.5f*y3;
-        const float a2 = -0.5f*y0             + 0.5f*y2;
-
-        return ((a0*t + a1)*t + a2)*t + y1;
+        const auto tap = line.template tap<Interp::WIDTH> (readPos, delaySamples);
+        window.load (lane, tap.frames, NumChannels, c, tap.frac);
     }
 
     // ─────────────────────────────────────────────────────────────────
@@ -325,3 +1123,6 @@ private:
         return y / drive;
     }
 };
+
+/** Left/right tape loop in lockstep (lanes 0/1). */
+using StereoTapeDelay = TapeDelay<2>;
@@ -1,5 +1,6 @@
 #pragma once
 #include <JuceHeader.h>
+#include "RandomSeed.h"
 #include <cstdint>
 
 /**
@@ -12,9 +13,14 @@
 class TapeNoise
 {
 public:
-    void prepare (double sampleRate)
+    /** @param seed     RandomSeed for the hiss generator (0 = historical hiss).
+        @param channel  Each channel hisses on its own stream (channel 0 keeps
+                        the historical one), so stereo hiss is not mono. */
+    void prepare (double sampleRate, uint32_t seed = 0, int channel = 0)
     {
         sr = (float) sampleRate;
+        randomSeed = seed;
+        streamBase = SEED_BASE ^ (static_cast<uint32_t> (channel) * 0x9E3779B9u);
 
         // One-pole HP at 200 Hz  (removes low rumble)
         hpCoeff = std::exp (-juce::MathConstants<float>::twoPi * 200.f / sr);
@@ -29,6 +35,7 @@ public:
     {
         hpState = 0.f;
         lpState = 0.f;
+        state   = RandomSeed::derive (streamBase, randomSeed);
     }
 
     /** Call once per sample.  Returns noise scaled by amount. */
@@ -55,9 +62,21 @@ public:
         return hp * amount * 0.04f;
     }
 
+    /** Adds hiss into io; amount is indexed per sample (array or constant accessor). */
+    template <typename Amount>
+    void processBlock (float* io, Amount amount, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            io[i] += process (amount[i]);
+    }
+
 private:
+    static constexpr uint32_t SEED_BASE = 0xDEAD1337u;
+
     float    sr      = 44100.f;
     float    hpCoeff = 0.999f, lpCoeff = 0.5f;
     float    hpState = 0.f,    lpState = 0.f;
-    uint32_t state   = 0xDEAD1337u; // xorshift32 seed
+    uint32_t state      = SEED_BASE; // xorshift32 state
+    uint32_t randomSeed = 0;
+    uint32_t streamBase = SEED_BASE; // this channel's generator base
 };
@@ -0,0 +1,264 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+
+/**
+ *  ParameterTable — single compile-time table describing every parameter.
+ *
+ *  The table drives:
+ *   • createLayout()  — the APVTS ParameterLayout (ranges, defaults, text)
+ *   • resolve()       — std::atomic<float>* lookup, done once per instance
+ *   • snapshot()      — plain-value copy of every parameter, once per block
+ *   • SMOOTHED        — which parameters get a per-sample 20 ms ramp
+ *
+ *  The audio thread and editor timer never look parameters up by string.
+ */
+struct ParameterTable
+{
+    enum Param : int
+    {
+        inputGain, repeatRate, intensity, bass, treble, echoLevel, reverbLevel,
+        wowFlutter, saturation, mode, tapeNoise, shimmer, freeze, pingpong,
+        sync, syncDiv, oversampling, interpolation, reverbEngine, springChirp,
+        shimmerEngine, shimmerVoicing, longRate, multiTap,
+        NUM_PARAMS
+    };
+
+    enum class Type      { Float, Int, Bool };
+    enum class Unit      { None, Ms, Db, SyncDiv, Oversampling, Interpolation, ReverbEngine,
+                                 ShimmerEngine, ShimmerVoicing };
+    enum class Smoothing { None, Linear };
+
+    struct Spec
+    {
+        Param       param;
+        const char* id;
+        const char* name;
+        Type        type;
+        float       min, max, def;
+        Unit        unit;
+        Smoothing   smoothing;
+        int         versionHint;
+    };
+
+    static constexpr std::array<Spec, NUM_PARAMS> SPECS = {{
+        { inputGain,   "inputGain",   "Input Gain",    Type::Float,   0.0f,  1.0f,  0.70f, Unit::None,    Smoothing::Linear, 1 },
+        { repeatRate,  "repeatRate",  "Repeat Rate",   Type::Float,  20.f,  500.f, 150.f,  Unit::Ms,      Smoothing::None,   1 }, // glided via tempo-sync smoother
+        { intensity,   "intensity",   "Intensity",     Type::Float,   0.0f,  0.95f, 0.40f, Unit::None,    Smoothing::Linear, 1 },
+        { bass,        "bass",        "Bass",          Type::Float, -12.0f, 12.0f,  0.0f,  Unit::Db,      Smoothing::None,   1 },
+        { treble,      "treble",      "Treble",        Type::Float, -12.0f, 12.0f,  0.0f,  Unit::Db,      Smoothing::None,   1 },
+        { echoLevel,   "echoLevel",   "Echo Level",    Type::Float,   0.0f,  1.0f,  0.70f, Unit::None,    Smoothing::Linear, 1 },
+        { reverbLevel, "reverbLevel", "Reverb Level",  Type::Float,   0.0f,  1.0f,  0.50f, Unit::None,    Smoothing::Linear, 1 },
+        { wowFlutter,  "wowFlutter",  "Wow / Flutter", Type::Float,   0.0f,  1.0f,  0.30f, Unit::None,    Smoothing::Linear, 1 },
+        { saturation,  "saturation",  "Saturation",    Type::Float,   0.0f,  1.0f,  0.30f, Unit::None,    Smoothing::Linear, 1 },
+        { mode,        "mode",        "Mode",          Type::Int,     0.0f, 11.0f,  0.0f,  Unit::None,    Smoothing::None,   1 },
+        { tapeNoise,   "tapeNoise",   "Tape Noise",    Type::Float,   0.0f,  1.0f,  0.15f, Unit::None,    Smoothing::Linear, 1 },
+        { shimmer,     "shimmer",     "Shimmer",       Type::Float,   0.0f,  1.0f,  0.0f,  Unit::None,    Smoothing::Linear, 1 },
+        { freeze,      "freeze",      "Freeze",        Type::Bool,    0.0f,  1.0f,  0.0f,  Unit::None,    Smoothing::None,   1 },
+        { pingpong,    "pingpong",    "Ping-Pong",     Type::Bool,    0.0f,  1.0f,  0.0f,  Unit::None,    Smoothing::None,   1 },
+        { sync,        "sync",        "Sync",          Type::Bool,    0.0f,  1.0f,  0.0f,  Unit::None,    Smoothing::None,   1 },
+        { syncDiv,     "syncDiv",     "Sync Division", Type::Int,     0.0f,  5.0f,  2.0f,  Unit::SyncDiv, Smoothing::None,   1 },
+        { oversampling, "oversampling", "Oversampling", Type::Int,    0.0f,  2.0f,  0.0f,  Unit::Oversampling, Smoothing::None, 2 },
+        { interpolation, "interpolation", "Interpolation", Type::Int, 0.0f,  3.0f,  1.0f,  Unit::Interpolation, Smoothing::None, 2 },
+        { reverbEngine, "reverbEngine", "Reverb Engine", Type::Int,   0.0f,  2.0f,  0.0f,  Unit::ReverbEngine, Smoothing::None, 3 },
+        { springChirp,  "springChirp",  "Spring Chirp",  Type::Bool,  0.0f,  1.0f,  0.0f,  Unit::None,    Smoothing::None,   3 },
+        { shimmerEngine,  "shimmerEngine",  "Shimmer Engine",  Type::Int,   0.0f,  1.0f,  0.0f,  Unit::ShimmerEngine,  Smoothing::None, 3 },
+        { shimmerVoicing, "shimmerVoicing", "Shimmer Voicing", Type::Int,   0.0f,  4.0f,  0.0f,  Unit::ShimmerVoicing, Smoothing::None, 3 },
+        { longRate,     "longRate",     "Long Rate",     Type::Bool,  0.0f,  1.0f,  0.0f,  Unit::None,    Smoothing::None,   3 },
+        { multiTap,     "multiTap",     "Multi-Tap",     Type::Bool,  0.0f,  1.0f,  0.0f,  Unit::None,    Smoothing::None,   3 }, // mode 13, over `mode`
+    }};
+
+    // ── Tempo-sync divisions (quarter-note beats, 4/4 assumption) ────
+    static constexpr int NUM_SYNC_DIVS = 6;
+    static constexpr const char* SYNC_DIV_NAMES[NUM_SYNC_DIVS] = { "1/16", "1/8", "1/4", "3/8", "1/2", "3/4" };
+    static constexpr float       SYNC_DIV_BEATS[NUM_SYNC_DIVS] = { 0.25f, 0.5f, 1.0f, 1.5f, 2.0f, 3.0f };
+
+    // ── Delay time: RATE (× LONG_RATE_SCALE when longRate is on) ─────
+    // repeatRate keeps its original range so saved automation still maps
+    static constexpr float LONG_RATE_SCALE = 20.f;
+    static constexpr float MAX_DELAY_MS    = 500.f * LONG_RATE_SCALE; // 10 s of tape
+
+    // ── Oversampling of the nonlinear stages (value = log2 factor) ───
+    static constexpr int NUM_OVERSAMPLING = 3;
+    static constexpr const char* OVERSAMPLING_NAMES[NUM_OVERSAMPLING] = { "1x", "2x", "4x" };
+
+    // ── Tape head interpolation (eco → mastering) ────────────────────
+    static constexpr int NUM_INTERPOLATION = 4;
+    static constexpr const char* INTERPOLATION_NAMES[NUM_INTERPOLATION] = { "Linear", "Catmull-Rom", "Lagrange", "Sinc" };
+
+    // ── Reverb tank (classic spring combs → dense FDN → measured IR) ─
+    static constexpr int NUM_REVERB_ENGINES = 3;
+    static constexpr const char* REVERB_ENGINE_NAMES[NUM_REVERB_ENGINES] = { "Spring", "FDN", "IR" };
+
+    // ── Shimmer pitch shifter (two grains → phase vocoder) ───────────
+    static constexpr int NUM_SHIMMER_ENGINES = 2;
+    static constexpr const char* SHIMMER_ENGINE_NAMES[NUM_SHIMMER_ENGINES] = { "Granular", "Spectral" };
+
+    // ── Shimmer intervals, semitones (either engine) ─────────────────
+    static constexpr int NUM_SHIMMER_VOICINGS = 5;
+    static constexpr int MAX_SHIMMER_VOICES   = 4;
+    static constexpr const char* SHIMMER_VOICING_NAMES[NUM_SHIMMER_VOICINGS] =
+        { "Octave", "Fifth + Octave", "Octave + 12th", "Sub + Octave", "Pad" };
+    static constexpr int   SHIMMER_VOICE_COUNTS[NUM_SHIMMER_VOICINGS] = { 1, 2, 2, 2, 4 };
+    static constexpr float SHIMMER_VOICE_SEMITONES[NUM_SHIMMER_VOICINGS][MAX_SHIMMER_VOICES] =
+        { { 12.f }, { 7.f, 12.f }, { 12.f, 19.f }, { -12.f, 12.f }, { -12.f, 7.f, 12.f, 19.f } };
+
+    // ── Smoothed parameters (slot order = table order) ───────────────
+    static constexpr int countSmoothed() noexcept
+    {
+        int n = 0;
+        for (const auto& spec : SPECS)
+            if (spec.smoothing != Smoothing::None) ++n;
+        return n;
+    }
+
+    /** Index into a NUM_SMOOTHED-sized array for a smoothed parameter. */
+    static constexpr int smoothedSlot (Param p) noexcept
+    {
+        int slot = 0;
+        for (const auto& spec : SPECS)
+        {
+            if (spec.param == p)
+                return spec.smoothing != Smoothing::None ? slot : -1;
+            if (spec.smoothing != Smoothing::None) ++slot;
+        }
+        return -1;
+    }
+
+    template <size_t N>
+    static constexpr std::array<Param, N> makeSmoothedList() noexcept
+    {
+        std::array<Param, N> list {};
+        size_t slot = 0;
+        for (const auto& spec : SPECS)
+            if (spec.smoothing != Smoothing::None)
+                list[slot++] = spec.param;
+        return list;
+    }
+
+    static constexpr bool isTableOrdered() noexcept
+    {
+        for (size_t i = 0; i < SPECS.size(); ++i)
+            if (SPECS[i].param != static_cast<Param> (i)) return false;
+        return true;
+    }
+};
+
+/**
+ *  ParameterRegistry — ParameterTable + per-instance cached atomics.
+ */
+class ParameterRegistry : public ParameterTable
+{
+public:
+    static_assert (isTableOrdered(), "SPECS must be listed in Param order");
+
+    static constexpr int NUM_SMOOTHED = countSmoothed();
+    static constexpr std::array<Param, NUM_SMOOTHED> SMOOTHED = makeSmoothedList<NUM_SMOOTHED>();
+
+    static const char* getID (Param p) noexcept { return SPECS[(size_t) p].id; }
+
+    // ─────────────────────────────────────────────────────────────────
+    static juce::AudioProcessorValueTreeState::ParameterLayout createLayout()
+    {
+        std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
+
+        for (const auto& spec : SPECS)
+        {
+            const juce::ParameterID pid { spec.id, spec.versionHint };
+
+            switch (spec.type)
+            {
+                case Type::Float:
+                {
+                    juce::AudioParameterFloatAttributes attr;
+                    if (spec.unit == Unit::Ms)
+                        attr = attr.withStringFromValueFunction ([] (float v, int) {
+                            return juce::String ((int) v) + " ms"; });
+                    else if (spec.unit == Unit::Db)
+                        attr = attr.withStringFromValueFunction ([] (float v, int) {
+                            return juce::String (v, 1) + " dB"; });
+
+                    params.push_back (std::make_unique<juce::AudioParameterFloat> (
+                        pid, spec.name, juce::NormalisableRange<float> (spec.min, spec.max),
+                        spec.def, attr));
+                    break;
+                }
+
+                case Type::Int:
+                {
+                    juce::AudioParameterIntAttributes attr;
+                    if (spec.unit == Unit::SyncDiv)
+                        attr = attr.withStringFromValueFunction ([] (int v, int) -> juce::String {
+                            return (v >= 0 && v < NUM_SYNC_DIVS) ? SYNC_DIV_NAMES[v] : "?"; });
+                    else if (spec.unit == Unit::Oversampling)
+                        attr = attr.withStringFromValueFunction ([] (int v, int) -> juce::String {
+                            return (v >= 0 && v < NUM_OVERSAMPLING) ? OVERSAMPLING_NAMES[v] : "?"; })
+                                   .withAutomatable (false); // changes the reported latency
+                    else if (spec.unit == Unit::Interpolation)
+                        attr = attr.withStringFromValueFunction ([] (int v, int) -> juce::String {
+                            return (v >= 0 && v < NUM_INTERPOLATION) ? INTERPOLATION_NAMES[v] : "?"; });
+                    else if (spec.unit == Unit::ReverbEngine)
+                        attr = attr.withStringFromValueFunction ([] (int v, int) -> juce::String {
+                            return (v >= 0 && v < NUM_REVERB_ENGINES) ? REVERB_ENGINE_NAMES[v] : "?"; });
+                    else if (spec.unit == Unit::ShimmerEngine)
+                        attr = attr.withStringFromValueFunction ([] (int v, int) -> juce::String {
+                            return (v >= 0 && v < NUM_SHIMMER_ENGINES) ? SHIMMER_ENGINE_NAMES[v] : "?"; });
+                    else if (spec.unit == Unit::ShimmerVoicing)
+                        attr = attr.withStringFromValueFunction ([] (int v, int) -> juce::String {
+                            return (v >= 0 && v < NUM_SHIMMER_VOICINGS) ? SHIMMER_VOICING_NAMES[v] : "?"; });
+
+                    params.push_back (std::make_unique<juce::AudioParameterInt> (
+                        pid, spec.name, (int) spec.min, (int) spec.max, (int) spec.def, attr));
+                    break;
+                }
+
+                case Type::Bool:
+                    params.push_back (std::make_unique<juce::AudioParameterBool> (
+                        pid, spec.name, spec.def > 0.5f));
+                    break;
+            }
+        }
+
+        return { params.begin(), params.end() };
+    }
+
+    // ─────────────────────────────────────────────────────────────────
+    /** Plain copy of every parameter value, taken once per block. */
+    struct Snapshot
+    {
+        std::array<float, NUM_PARAMS> values {};
+
+        float get     (Param p) const noexcept { return values[(size_t) p]; }
+        int   getInt  (Param p) const noexcept { return static_cast<int> (values[(size_t) p]); }
+        bool  getBool (Param p) const noexcept { return values[(size_t) p] > 0.5f; }
+    };
+
+    /** Resolve the raw parameter atomics once (constructor time). */
+    void resolve (juce::AudioProcessorValueTreeState& apvts)
+    {
+        for (const auto& spec : SPECS)
+        {
+            raw[(size_t) spec.param] = apvts.getRawParameterValue (spec.id);
+            jassert (raw[(size_t) spec.param] != nullptr);
+        }
+    }
+
+    float load (Param p) const noexcept
+    {
+        return raw[(size_t) p]->load (std::memory_order_relaxed);
+    }
+
+    Snapshot snapshot() const noexcept
+    {
+        Snapshot snap;
+        for (size_t i = 0; i < raw.size(); ++i)
+            snap.values[i] = raw[i]->load (std::memory_order_relaxed);
+        return snap;
+    }
+
+private:
+    std::array<std::atomic<float>*, NUM_PARAMS> raw {};
+};
+
+using ParameterSnapshot = ParameterRegistry::Snapshot;
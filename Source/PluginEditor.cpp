@@ -63,6 +63,9 @@ SpaceEchoAudioProcessorEditor::SpaceEchoAudioProcessorEditor (SpaceEchoAudioProc
     // ── Oscilloscope ──────────────────────────────────────────────────
     addAndMakeVisible (oscilloscope);
 
+    // ── Diagnostics overlay (hidden until the logo is double-clicked) ─
+    addChildComponent (diagnostics);
+
     // ── Test tone button ───────────────────────────────────────────────
     styliseToggleButton (testToneBtn,
         juce::Colour (0xFF2A2A2A), juce::Colour (0xFFCC4400),
@@ -70,6 +73,14 @@ SpaceEchoAudioProcessorEditor::SpaceEchoAudioProcessorEditor (SpaceEchoAudioProc
     testToneBtn.onClick = [this] { processor.setTestTone (testToneBtn.getToggleState()); };
     addAndMakeVisible (testToneBtn);
 
+    // ── ENGINE menu (state properties, applied at the next prepareToPlay) ─
+    styliseToggleButton (engineBtn,
+        juce::Colour (0xFF2A2A2A), juce::Colour (0xFF2A2A2A),
+        juce::Colour (0xFFAAAAAA), juce::Colours::white);
+    engineBtn.setClickingTogglesState (false); // opens a menu
+    engineBtn.onClick = [this] { showEngineMenu(); };
+    addAndMakeVisible (engineBtn);
+
     // ── FREEZE button ──────────────────────────────────────────────────
     styliseToggleButton (freezeBtn,
         juce::Colour (0xFF1A2A3A), juce::Colour (0xFF004EBB),
@@ -97,23 +108,48 @@ SpaceEchoAudioProcessorEditor::SpaceEchoAudioProcessorEditor (SpaceEchoAudioProc
     syncAttachment = std::make_unique<juce::ButtonParameterAttachment> (
         *apvts.getParameter ("sync"), syncBtn, apvts.undoManager);
 
+    // ── LONG button (RATE × 20, up to 10 s) ────────────────────────────
+    styliseToggleButton (longRateBtn,
+        juce::Colour (0xFF2A2A1A), juce::Colour (0xFF886600),
+        juce::Colour (0xFFBBAA55), juce::Colours::white);
+    addAndMakeVisible (longRateBtn);
+
+    longRateAttachment = std::make_unique<juce::ButtonParameterAttachment> (
+        *apvts.getParameter ("longRate"), longRateBtn, apvts.undoManager);
+
     // ── Mode selector ──────────────────────────────────────────────────
     addAndMakeVisible (modeSelector);
 
+    // Dial positions 1–12 are the `mode` parameter, 13 (TAPS) is multiTap
     modeAttachment = std::make_unique<juce::ParameterAttachment> (
         *apvts.getParameter ("mode"),
-        [this] (float v) { modeSelector.setMode (static_cast<int> (v)); },
+        [this] (float v)
+        {
+            if (processor.getParameterRegistry().load (ParameterRegistry::multiTap) < 0.5f)
+                modeSelector.setMode (static_cast<int> (v));
+        },
+        apvts.undoManager);
+
+    multiTapAttachment = std::make_unique<juce::ParameterAttachment> (
+        *apvts.getParameter ("multiTap"),
+        [this] (float v)
+        {
+            modeSelector.setMode (v > 0.5f ? SpaceEchoAudioProcessor::TAPS_MODE
+                                           : static_cast<int> (processor.getParameterRegistry()
+                                                                   .load (ParameterRegistry::mode)));
+        },
         apvts.undoManager);
 
     modeSelector.onModeChanged = [this] (int m)
     {
-        if (auto* param = processor.apvts.getParameter ("mode"))
-        {
-            const float norm = param->convertTo0to1 (static_cast<float> (m));
-            param->setValueNotifyingHost (norm);
-        }
+        const bool taps = m == SpaceEchoAudioProcessor::TAPS_MODE;
+        if (! taps)
+            modeAttachment->setValueAsCompleteGesture (static_cast<float> (m));
+        multiTapAttachment->setValueAsCompleteGesture (taps ? 1.f : 0.f);
     };
 
+    multiTapAttachment->sendInitialUpdate(); // shows TAPS or the dial position
+
     // ── Style knob labels and text boxes ──────────────────────────────
     auto styliseLabel = [&] (juce::Label& l)
     {
@@ -425,6 +461,23 @@ void SpaceEchoAudioProcessorEditor::paint (juce::Graphics& g)
     }
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+//  Engine settings menu — they reallocate, so they apply when playback restarts
+// ─────────────────────────────────────────────────────────────────────────────
+void SpaceEchoAudioProcessorEditor::showEngineMenu()
+{
+    juce::PopupMenu menu;
+    menu.addSectionHeader ("Applied when playback restarts");
+
+    menu.addItem ("Compact tape (16-bit)", true, processor.isCompactTapeStorage(),
+                  [this] { processor.setCompactTapeStorage (! processor.isCompactTapeStorage()); });
+
+    menu.addItem ("Reduced loop rate (88.2 kHz and up)", true, processor.isReducedLoopRate(),
+                  [this] { processor.setReducedLoopRate (! processor.isReducedLoopRate()); });
+
+    menu.showMenuAsync (juce::PopupMenu::Options().withTargetComponent (engineBtn));
+}
+
 // ─────────────────────────────────────────────────────────────────────────────
 //  resized  — place all child components
 // ─────────────────────────────────────────────────────────────────────────────
@@ -434,8 +487,12 @@ void SpaceEchoAudioProcessorEditor::resized()
     freezeBtn  .setBounds (330,     9, 110, 34);
     pingpongBtn.setBounds (448,     9, 130, 34);
     syncBtn    .setBounds (586,     9,  72, 34);
+    longRateBtn.setBounds (666,     9,  72, 34);
+    engineBtn  .setBounds (W - 214, 9,  94, 34);
     testToneBtn.setBounds (W - 112, 9, 102, 34);
 
+    diagnostics.setBounds (120, 70, W - 240, 220);
+
     // ── LEFT panel ───────────────────────────────────────────────────
 
     // Analog VU meters (88 × 120, side by side with 8px gap)
@@ -523,12 +580,34 @@ void SpaceEchoAudioProcessorEditor::timerCallback()
                           processor.getScopeWritePos());
 
     // ── Tape reel rotation ────────────────────────────────────────────
-    const float rateMs = *processor.apvts.getRawParameterValue ("repeatRate");
-    const bool  frozen = *processor.apvts.getRawParameterValue ("freeze") > 0.5f;
+    const auto& params = processor.getParameterRegistry();
+    const float rateMs = params.load (ParameterRegistry::repeatRate)
+                       * (params.load (ParameterRegistry::longRate) > 0.5f ? ParameterRegistry::LONG_RATE_SCALE : 1.f);
+    const bool  frozen = params.load (ParameterRegistry::freeze) > 0.5f;
 
     const float rps    = 1.5f / (rateMs * 0.001f);
     const float dAngle = rps * juce::MathConstants<float>::twoPi / 30.f;
 
     tapeReels.setFrozen (frozen);
     tapeReels.advance (dAngle);
+
+    // ── Diagnostics (5 Hz is plenty to read) ──────────────────────────
+    if (diagnostics.isVisible() && ++diagnosticsTick % 6 == 0)
+        diagnostics.refresh();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  mouseDoubleClick — the SPACE ECHO logo toggles the diagnostics overlay
+// ─────────────────────────────────────────────────────────────────────────────
+void SpaceEchoAudioProcessorEditor::mouseDoubleClick (const juce::MouseEvent& e)
+{
+    if (! juce::Rectangle<int> (14, 0, 280, 52).contains (e.getPosition()))
+        return;
+
+    diagnostics.setVisible (! diagnostics.isVisible());
+    if (diagnostics.isVisible())
+    {
+        diagnostics.toFront (false);
+        diagnostics.refresh();
+    }
 }
@@ -6,6 +6,7 @@
 #include "UI/ModeSelector.h"
 #include "UI/TapeReelComponent.h"
 #include "UI/OscilloscopeComponent.h"
+#include "UI/DiagnosticsOverlay.h"
 
 /**
  *  SpaceEchoAudioProcessorEditor  v1.3 — Roland RE-201 faithful layout
@@ -37,6 +38,7 @@ public:
     void paint   (juce::Graphics&) override;
     void resized () override;
     void timerCallback() override;
+    void mouseDoubleClick (const juce::MouseEvent&) override;
 
 private:
     SpaceEchoAudioProcessor& processor;
@@ -59,18 +61,29 @@ private:
     // ── Test tone button ──────────────────────────────────────────────
     juce::TextButton testToneBtn { "TEST" };
 
-    // ── FREEZE / PING-PONG / SYNC toggle buttons ─────────────────────
+    // ── Engine settings (compact tape, reduced loop rate) ─────────────
+    juce::TextButton engineBtn { "ENGINE" };
+    void showEngineMenu();
+
+    // ── Hidden stage-timing overlay (double-click the logo) ───────────
+    DiagnosticsOverlay diagnostics { processor.getProfiler() };
+    int diagnosticsTick = 0;
+
+    // ── FREEZE / PING-PONG / SYNC / LONG toggle buttons ──────────────
     juce::TextButton freezeBtn    { "FREEZE"    };
     juce::TextButton pingpongBtn  { "PING-PONG" };
     juce::TextButton syncBtn      { "SYNC"      };
+    juce::TextButton longRateBtn  { "LONG"      };
 
     std::unique_ptr<juce::ButtonParameterAttachment> freezeAttachment;
     std::unique_ptr<juce::ButtonParameterAttachment> pingpongAttachment;
     std::unique_ptr<juce::ButtonParameterAttachment> syncAttachment;
+    std::unique_ptr<juce::ButtonParameterAttachment> longRateAttachment;
 
     // ── Mode selector ─────────────────────────────────────────────────
     ModeSelector modeSelector;
     std::unique_ptr<juce::ParameterAttachment> modeAttachment;
+    std::unique_ptr<juce::ParameterAttachment> multiTapAttachment;
 
     // ── Knobs (sliders in rotary mode) ────────────────────────────────
     struct LabelledKnob
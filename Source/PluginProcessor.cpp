@@ -1,24 +1,19 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
 
-// ─────────────────────────────────────────────────────────────────────────────
-//  Mode table
-// ─────────────────────────────────────────────────────────────────────────────
-const SpaceEchoAudioProcessor::ModeConfig SpaceEchoAudioProcessor::MODE_TABLE[12] =
-{
-    {{ true,  false, false }, false }, // 1  – H1
-    {{ false,  true, false }, false }, // 2  – H2
-    {{ false, false,  true }, false }, // 3  – H3
-    {{ true,   true, false }, false }, // 4  – H1+H2
-    {{ true,  false,  true }, false }, // 5  – H1+H3
-    {{ false,  true,  true }, false }, // 6  – H2+H3
-    {{ true,   true,  true }, false }, // 7  – ALL
-    {{ true,  false, false },  true }, // 8  – H1+Reverb
-    {{ false,  true, false },  true }, // 9  – H2+Reverb
-    {{ false, false,  true },  true }, // 10 – H3+Reverb
-    {{ true,   true,  true },  true }, // 11 – ALL+Reverb
-    {{ false, false, false },  true }, // 12 – Reverb only
-};
+using P = ParameterRegistry;
+
+static_assert (P::NUM_INTERPOLATION == StereoTapeDelay::NUM_INTERPOLATORS,
+               "interpolation parameter and tape readers out of step");
+static_assert (P::NUM_REVERB_ENGINES == SpringReverb::NUM_ENGINES,
+               "reverb engine parameter and spring tanks out of step");
+static_assert (P::MAX_SHIMMER_VOICES == ShimmerChorus::MAX_VOICES
+                   && P::MAX_SHIMMER_VOICES == SpectralShimmer::MAX_VOICES,
+               "shimmer voicings and shimmer engine voices out of step");
+static_assert (static_cast<int> (P::SPECS[P::mode].max) == SpaceEchoAudioProcessor::TAPS_MODE - 1
+                   && SpaceEchoAudioProcessor::MODE_TABLE[SpaceEchoAudioProcessor::TAPS_MODE].taps
+                   && ModeSelector::NUM_MODES == SpaceEchoAudioProcessor::NUM_MODES,
+               "mode / multiTap parameters, selector and MODE_TABLE out of step");
 
 // ─────────────────────────────────────────────────────────────────────────────
 //  Parameter layout
@@ -26,61 +21,7 @@ const SpaceEchoAudioProcessor::ModeConfig SpaceEchoAudioProcessor::MODE_TABLE[12
 juce::AudioProcessorValueTreeState::ParameterLayout
 SpaceEchoAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    auto makeFloat = [&] (const juce::String& id, const juce::String& name,
-                          float lo, float hi, float def,
-                          std::function<juce::String (float, int)> strFn = nullptr)
-    {
-        juce::NormalisableRange<float> range (lo, hi);
-        if (strFn)
-            params.push_back (std::make_unique<juce::AudioParameterFloat> (
-                juce::ParameterID { id, 1 }, name, range, def,
-                juce::AudioParameterFloatAttributes().withStringFromValueFunction (strFn)));
-        else
-            params.push_back (std::make_unique<juce::AudioParameterFloat> (
-                juce::ParameterID { id, 1 }, name, range, def));
-    };
-
-    makeFloat ("inputGain",   "Input Gain",    0.0f,  1.0f,  0.70f);
-    makeFloat ("repeatRate",  "Repeat Rate",   20.f,  500.f, 150.f,
-               [] (float v, int) { return juce::String ((int) v) + " ms"; });
-    makeFloat ("intensity",   "Intensity",     0.0f,  0.95f, 0.40f);
-    makeFloat ("bass",        "Bass",         -12.0f, 12.0f, 0.0f,
-               [] (float v, int) { return juce::String (v, 1) + " dB"; });
-    makeFloat ("treble",      "Treble",       -12.0f, 12.0f, 0.0f,
-               [] (float v, int) { return juce::String (v, 1) + " dB"; });
-    makeFloat ("echoLevel",   "Echo Level",    0.0f,  1.0f,  0.70f);
-    makeFloat ("reverbLevel", "Reverb Level",  0.0f,  1.0f,  0.50f);
-    makeFloat ("wowFlutter",  "Wow / Flutter", 0.0f,  1.0f,  0.30f);
-    makeFloat ("saturation",  "Saturation",    0.0f,  1.0f,  0.30f);
-
-    params.push_back (std::make_unique<juce::AudioParameterInt> (
-        juce::ParameterID { "mode", 1 }, "Mode", 0, 11, 0));
-
-    makeFloat ("tapeNoise", "Tape Noise", 0.0f, 1.0f, 0.15f);
-    makeFloat ("shimmer",   "Shimmer",    0.0f, 1.0f, 0.0f);
-
-    params.push_back (std::make_unique<juce::AudioParameterBool> (
-        juce::ParameterID { "freeze",   1 }, "Freeze",    false));
-    params.push_back (std::make_unique<juce::AudioParameterBool> (
-        juce::ParameterID { "pingpong", 1 }, "Ping-Pong", false));
-
-    // ── Tempo sync ────────────────────────────────────────────────────
-    params.push_back (std::make_unique<juce::AudioParameterBool> (
-        juce::ParameterID { "sync", 1 }, "Sync", false));
-
-    // Division index → quarter-note beats: 0=1/16, 1=1/8, 2=1/4, 3=3/8, 4=1/2, 5=3/4
-    static const char* divNames[] = { "1/16", "1/8", "1/4", "3/8", "1/2", "3/4" };
-    params.push_back (std::make_unique<juce::AudioParameterInt> (
-        juce::ParameterID { "syncDiv", 1 }, "Sync Division", 0, 5, 2,
-        juce::AudioParameterIntAttributes()
-            .withStringFromValueFunction ([](int v, int) -> juce::String {
-                const char* names[] = { "1/16", "1/8", "1/4", "3/8", "1/2", "3/4" };
-                return (v >= 0 && v <= 5) ? names[v] : "?";
-            })));
-
-    return { params.begin(), params.end() };
+    return ParameterRegistry::createLayout();
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -92,33 +33,67 @@ SpaceEchoAudioProcessor::SpaceEchoAudioProcessor()
                           .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
       apvts (*this, nullptr, "SpaceEchoState", createParameterLayout())
 {
+    params.resolve (apvts);
+    publishTapPattern (getTapPattern());
 }
 
-SpaceEchoAudioProcessor::~SpaceEchoAudioProcessor() {}
+SpaceEchoAudioProcessor::~SpaceEchoAudioProcessor()
+{
+    cancelPendingUpdate();
+}
 
 // ─────────────────────────────────────────────────────────────────────────────
 //  Prepare
 // ─────────────────────────────────────────────────────────────────────────────
-void SpaceEchoAudioProcessor::prepareToPlay (double sampleRate, int /*samplesPerBlock*/)
+void SpaceEchoAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
     currentSampleRate = sampleRate;
     feedbackL = feedbackR = 0.f;
     shimFeedL = shimFeedR = 0.f;
 
-    tapeL.prepare (sampleRate, 750.f, 0.0f);
-    tapeR.prepare (sampleRate, 750.f, 0.37f);
+    const auto seed = getRandomSeed();
+
+    const int loopFactor = isReducedLoopRate() ? LoopResampler<2>::chooseFactor (sampleRate, MIN_LOOP_RATE) : 1;
+    loopSampleRate = sampleRate / loopFactor;
+    loopResampler.prepare (loopFactor, MAX_SUB_BLOCK);
 
-    springL.prepare (sampleRate);
-    springR.prepare (sampleRate);
+    tape.prepare (loopSampleRate, P::MAX_DELAY_MS, { 0.0f, 0.37f }, MAX_SUB_BLOCK,
+                  isCompactTapeStorage(), seed);
+    tape.setExternalLatency (static_cast<float> (loopResampler.getLatency()));
 
-    noiseL.prepare (sampleRate);
-    noiseR.prepare (sampleRate);
+    outputOversampler.prepare (MAX_SUB_BLOCK);
+    oversamplingLog2 = -1;
+    applyOversampling (static_cast<int> (params.load (P::oversampling)));
+    cancelPendingUpdate();
+    setLatencySamples (outputLatency.load());
+    tape.setInterpolation (static_cast<int> (params.load (P::interpolation)));
+    publishTapPattern (getTapPattern());
+    applyPendingTapPattern();
+
+    springL.prepare (sampleRate, samplesPerBlock);
+    springR.prepare (sampleRate, samplesPerBlock);
+    installSpringImpulseResponse();
+    springL.setEngine (static_cast<int> (params.load (P::reverbEngine)));
+    springR.setEngine (static_cast<int> (params.load (P::reverbEngine)));
+    springL.setChirp  (params.load (P::springChirp) > 0.5f);
+    springR.setChirp  (params.load (P::springChirp) > 0.5f);
+
+    noiseL.prepare (sampleRate, seed, 0);
+    noiseR.prepare (sampleRate, seed, 1);
 
     shimmerL.prepare (sampleRate);
     shimmerR.prepare (sampleRate);
+    spectralL.prepare (sampleRate, samplesPerBlock);
+    spectralR.prepare (sampleRate, samplesPerBlock);
+    shimmerEngine = shimmerVoicing = -1;
+    applyShimmerSettings (static_cast<int> (params.load (P::shimmerEngine)),
+                          static_cast<int> (params.load (P::shimmerVoicing)));
+
+    // prepare() stopped the background threads; only engines in use get them back
+    updateWorkerThreads();
 
-    // Shelving EQ filters
-    juce::dsp::ProcessSpec spec { sampleRate, 512, 1 };
+    // Shelving EQ filters (in the tape loop)
+    juce::dsp::ProcessSpec spec { loopSampleRate, 512, 1 };
     bassL.prepare  (spec); bassL.reset();
     bassR.prepare  (spec); bassR.reset();
     trebleL.prepare(spec); trebleL.reset();
@@ -128,25 +103,24 @@ void SpaceEchoAudioProcessor::prepareToPlay (double sampleRate, int /*samplesPer
     updateEQ (0.f, 0.f);
 
     // ── Parameter smoothers (20 ms ramp — eliminates zipper noise) ───
-    const double rampSec = 0.020;
-    auto initSmoother = [&] (auto& sm, const juce::String& id)
-    {
-        sm.reset (sampleRate, rampSec);
-        sm.setCurrentAndTargetValue (*apvts.getRawParameterValue (id));
-    };
+    smoothing.reset (sampleRate, 0.020);
+    for (int i = 0; i < P::NUM_SMOOTHED; ++i)
+        smoothing.setCurrentAndTargetValue (i, params.load (P::SMOOTHED[(size_t) i]));
 
-    initSmoother (smInputGain,   "inputGain");
-    initSmoother (smIntensity,   "intensity");
-    initSmoother (smEchoLevel,   "echoLevel");
-    initSmoother (smReverbLevel, "reverbLevel");
-    initSmoother (smWowFlutter,  "wowFlutter");
-    initSmoother (smSaturation,  "saturation");
-    initSmoother (smTapeNoise,   "tapeNoise");
-    initSmoother (smShimmer,     "shimmer");
+    // Sync-delay glide initialised at the current delay (tempo-synced or not)
+    smoothing.setCurrentAndTargetValue (DELAY_SLOT, getEffectiveDelayMs (params.snapshot()));
 
-    // Sync-delay smoother initialised at current repeatRate value
-    smSyncDelay.reset (sampleRate, rampSec);
-    smSyncDelay.setCurrentAndTargetValue (*apvts.getRawParameterValue ("repeatRate"));
+    // Hosts read the tail right after preparing: report it from the current
+    // settings rather than the default or the previous session's last block
+    {
+        const auto snap = params.snapshot();
+        updateTailLength (snap, getModeIndex (snap), snap.getBool (P::freeze));
+    }
+
+    // Every render starts from the same point
+    testTonePhase = testTonePhase2 = testToneTrigger = 0.f;
+    lastModeIndex = 0;
+    sleeping      = false;
 
     scopeBuffer.fill (0.f);
     scopeWritePos.store (0, std::memory_order_relaxed);
@@ -154,10 +128,25 @@ void SpaceEchoAudioProcessor::prepareToPlay (double sampleRate, int /*samplesPer
 
 void SpaceEchoAudioProcessor::releaseResources()
 {
-    tapeL.reset(); tapeR.reset();
+    tape.reset();
+    loopResampler.reset();
     springL.reset(); springR.reset();
     noiseL.reset(); noiseR.reset();
+    outputOversampler.reset();
     shimmerL.reset(); shimmerR.reset();
+    spectralL.reset(); spectralR.reset();
+}
+
+/** Offline renders run the worker-thread tails inline; the engines switch
+    over at their next idle point, so hosts may call this while playing. */
+void SpaceEchoAudioProcessor::setNonRealtime (bool isNonRealtime) noexcept
+{
+    AudioProcessor::setNonRealtime (isNonRealtime);
+    springL  .setNonRealtime (isNonRealtime);
+    springR  .setNonRealtime (isNonRealtime);
+    spectralL.setNonRealtime (isNonRealtime);
+    spectralR.setNonRealtime (isNonRealtime);
+    triggerAsyncUpdate();
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -171,7 +160,7 @@ void SpaceEchoAudioProcessor::updateEQ (float bassDb, float trebleDb)
     cachedBassDb   = bassDb;
     cachedTrebleDb = trebleDb;
 
-    const double sr = currentSampleRate;
+    const double sr = loopSampleRate;
     *bassL.coefficients   = *juce::dsp::IIR::Coefficients<float>::makeLowShelf (
         sr, 200.0, 0.7, juce::Decibels::decibelsToGain (bassDb));
     *bassR.coefficients   = *bassL.coefficients;
@@ -182,72 +171,153 @@ void SpaceEchoAudioProcessor::updateEQ (float bassDb, float trebleDb)
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
-//  processBlock
+//  Oversampling of the nonlinear stages — tape record head + output clip
 // ─────────────────────────────────────────────────────────────────────────────
-void SpaceEchoAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                            juce::MidiBuffer& /*midi*/)
+bool SpaceEchoAudioProcessor::applyOversampling (int factorLog2) noexcept
 {
-    juce::ScopedNoDenormals noDenormals;
+    factorLog2 = juce::jlimit (0, P::NUM_OVERSAMPLING - 1, factorLog2);
+    if (factorLog2 == oversamplingLog2)
+        return false;
 
-    // ── Block-rate params (bool / int / EQ) ──────────────────────────
-    const float bassDb   = *apvts.getRawParameterValue ("bass");
-    const float trebleDb = *apvts.getRawParameterValue ("treble");
-    const int   mode     = (int) *apvts.getRawParameterValue ("mode");
-    const bool  frozen   = *apvts.getRawParameterValue ("freeze")   > 0.5f;
-    const bool  pingpong = *apvts.getRawParameterValue ("pingpong") > 0.5f;
-    const float repeatMs = *apvts.getRawParameterValue ("repeatRate");
+    oversamplingLog2 = factorLog2;
 
-    // ── Tempo sync — compute effective delay time ─────────────────────
-    {
-        float effectiveDelayMs = repeatMs; // default: free rate from knob
+    // Record-head latency is compensated inside the tape loop; only the
+    // output stage delays the signal as a whole
+    tape.setRecordOversampling (factorLog2);
+    outputOversampler.setFactorLog2 (factorLog2);
+    outputLatency.store (juce::roundToInt (outputOversampler.getLatencySamples()));
+    return true;
+}
 
-        const bool syncOn = *apvts.getRawParameterValue ("sync") > 0.5f;
-        if (syncOn)
-        {
-            // Ask the host for the current BPM
-            if (auto* ph = getPlayHead())
-            {
-                if (auto pos = ph->getPosition())
-                    if (auto bpm = pos->getBpm())
-                        lastBpm = *bpm;
-            }
+/** Reports a latency or engine changed by processBlock — never from the audio thread. */
+void SpaceEchoAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples (outputLatency.load());
+    updateWorkerThreads();
+}
+
+/** Message thread: background threads run only for the engines in use, and
+    not at all offline (the engines then run their jobs inline). */
+void SpaceEchoAudioProcessor::updateWorkerThreads()
+{
+    const bool realtime    = ! isNonRealtime();
+    const bool convolution = realtime && springIr.getNumSamples() > 0
+                          && static_cast<int> (params.load (P::reverbEngine)) == SpringReverb::CONVOLUTION;
+    const bool spectral    = realtime
+                          && static_cast<int> (params.load (P::shimmerEngine)) == SPECTRAL_SHIMMER;
+
+    springL  .setWorkerRunning (convolution);
+    springR  .setWorkerRunning (convolution);
+    spectralL.setWorkerRunning (spectral);
+    spectralR.setWorkerRunning (spectral);
+}
 
-            // Division table — beats per quarter note (4/4 assumption)
-            // Index: 0=1/16, 1=1/8, 2=1/4, 3=3/8(dot-1/4), 4=1/2, 5=3/4(dot-1/2)
-            static const float DIV_BEATS[6] = { 0.25f, 0.5f, 1.0f, 1.5f, 2.0f, 3.0f };
-            const int div = juce::jlimit (0, 5,
-                (int) *apvts.getRawParameterValue ("syncDiv"));
+// ─────────────────────────────────────────────────────────────────────────────
+//  Shimmer engine + voicing — the engine switched in starts from silence
+// ─────────────────────────────────────────────────────────────────────────────
+void SpaceEchoAudioProcessor::applyShimmerSettings (int engine, int voicing) noexcept
+{
+    engine  = juce::jlimit (0, P::NUM_SHIMMER_ENGINES - 1, engine);
+    voicing = juce::jlimit (0, P::NUM_SHIMMER_VOICINGS - 1, voicing);
 
-            effectiveDelayMs = static_cast<float> (60.0 / lastBpm)
-                               * DIV_BEATS[div] * 1000.f;
-            effectiveDelayMs = juce::jlimit (20.f, 500.f, effectiveDelayMs);
+    if (engine != shimmerEngine)
+    {
+        shimmerEngine = engine;
+        triggerAsyncUpdate(); // start or stop the spectral threads
+        if (engine == SPECTRAL_SHIMMER)
+        {
+            spectralL.restart(); spectralR.restart();
         }
+        else
+        {
+            shimmerL.reset(); shimmerR.reset();
+        }
+    }
 
-        smSyncDelay.setTargetValue (effectiveDelayMs);
+    if (voicing != shimmerVoicing)
+    {
+        shimmerVoicing = voicing;
+        shimmerL .setVoices (P::SHIMMER_VOICE_SEMITONES[voicing], P::SHIMMER_VOICE_COUNTS[voicing]);
+        shimmerR .setVoices (P::SHIMMER_VOICE_SEMITONES[voicing], P::SHIMMER_VOICE_COUNTS[voicing]);
+        spectralL.setVoices (P::SHIMMER_VOICE_SEMITONES[voicing], P::SHIMMER_VOICE_COUNTS[voicing]);
+        spectralR.setVoices (P::SHIMMER_VOICE_SEMITONES[voicing], P::SHIMMER_VOICE_COUNTS[voicing]);
     }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  processBlock
+// ─────────────────────────────────────────────────────────────────────────────
+void SpaceEchoAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+                                            juce::MidiBuffer& /*midi*/)
+{
+    juce::ScopedNoDenormals noDenormals;
+    SPACEECHO_PROFILE_BLOCK (profiler, buffer.getNumSamples(), currentSampleRate);
+
+    // ── One snapshot of every parameter for the whole block ──────────
+    const auto snap = params.snapshot();
+
+    // ── Block-rate params (bool / int / EQ) ──────────────────────────
+    const float bassDb   = snap.get     (P::bass);
+    const float trebleDb = snap.get     (P::treble);
+    const bool  frozen   = snap.getBool (P::freeze);
+    const bool  pingpong = snap.getBool (P::pingpong);
+
+    // ── Tempo sync — compute effective delay time ─────────────────────
+    smoothing.setTargetValue (DELAY_SLOT, getEffectiveDelayMs (snap));
 
     updateEQ (bassDb, trebleDb);
-    tapeL.setFrozen (frozen);
-    tapeR.setFrozen (frozen);
+    if (applyOversampling (snap.getInt (P::oversampling)))
+        triggerAsyncUpdate();
+    tape.setInterpolation (snap.getInt (P::interpolation)); // before getSubBlockLength()
+    applyPendingTapPattern();
 
     // Reverb parameters (fixed for now, could expose later)
     springL.setSize    (0.65f); springR.setSize    (0.65f);
     springL.setDamping (0.35f); springR.setDamping (0.35f);
+    const int reverbEngine = springL.getEngine();
+    springL.setEngine  (snap.getInt (P::reverbEngine));
+    springR.setEngine  (snap.getInt (P::reverbEngine));
+    if (springL.getEngine() != reverbEngine)
+        triggerAsyncUpdate(); // start or stop the convolution threads
+    springL.setChirp   (snap.getBool (P::springChirp));
+    springR.setChirp   (snap.getBool (P::springChirp));
+    applyShimmerSettings (snap.getInt (P::shimmerEngine), snap.getInt (P::shimmerVoicing));
 
     // ── Set smoother targets (interpolated per-sample below) ──────────
-    smInputGain  .setTargetValue (*apvts.getRawParameterValue ("inputGain"));
-    smIntensity  .setTargetValue (*apvts.getRawParameterValue ("intensity"));
-    smEchoLevel  .setTargetValue (*apvts.getRawParameterValue ("echoLevel"));
-    smReverbLevel.setTargetValue (*apvts.getRawParameterValue ("reverbLevel"));
-    smWowFlutter .setTargetValue (*apvts.getRawParameterValue ("wowFlutter"));
-    smSaturation .setTargetValue (*apvts.getRawParameterValue ("saturation"));
-    smTapeNoise  .setTargetValue (*apvts.getRawParameterValue ("tapeNoise"));
-    smShimmer    .setTargetValue (*apvts.getRawParameterValue ("shimmer"));
-
-    const auto& mc = MODE_TABLE[juce::jlimit (0, 11, mode)];
-    int numHeads = 0;
-    for (int h = 0; h < TapeDelay::NUM_HEADS; ++h)
-        if (mc.heads[h]) ++numHeads;
+    for (int i = 0; i < P::NUM_SMOOTHED; ++i)
+        smoothing.setTargetValue (i, snap.get (P::SMOOTHED[(size_t) i]));
+
+    const int modeIndex = getModeIndex (snap);
+
+    // Echo-less modes skip the EQ; restart it from silence when the echo returns
+    if (! MODE_TABLE[lastModeIndex].hasEcho() && MODE_TABLE[modeIndex].hasEcho())
+    {
+        bassL.reset();   bassR.reset();
+        trebleL.reset(); trebleR.reset();
+    }
+    lastModeIndex = modeIndex;
+
+    updateTailLength (snap, modeIndex, frozen);
+
+    // ── Sleep — nothing coming in, nothing left in the loops ──────────
+    const bool testOn = testToneEnabled.load();
+
+    if (canSleep (buffer, modeIndex, testOn))
+    {
+        buffer.clear();
+        smoothing.skip (buffer.getNumSamples());
+
+        if (! sleeping)
+        {
+            scopeBuffer.fill (0.f);
+            inputLevelL .store (0.f);
+            outputLevelL.store (0.f);
+            sleeping = true;
+        }
+        return;
+    }
+
+    sleeping = false;
 
     // Stereo output setup
     const int totalIn  = getTotalNumInputChannels();
@@ -258,139 +328,586 @@ void SpaceEchoAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     auto* left  = buffer.getWritePointer (0);
     auto* right = buffer.getNumChannels() > 1 ? buffer.getWritePointer (1) : left;
 
-    float inAcc = 0.f, outAcc = 0.f;
-
-    // Test tone state
-    const bool  testOn    = testToneEnabled.load();
-    const float sr_f      = (float) currentSampleRate;
-    const float pulseLen  = sr_f * 1.5f;
+    BlockContext ctx;
 
     // Scope write position (local for this block)
-    int scopePos = scopeWritePos.load (std::memory_order_relaxed);
+    ctx.scopePos = scopeWritePos.load (std::memory_order_relaxed);
+
+    // ── Sub-block loop ────────────────────────────────────────────────
+    const int numSamples  = buffer.getNumSamples();
+    const int subBlockLen = getSubBlockLength();
+
+    for (int pos = 0; pos < numSamples; pos += subBlockLen)
+    {
+        // Re-checked per sub-block: ramps that finish mid-block drop to the
+        // constant-parameter kernel straight away
+        const auto kernel = getKernel (modeIndex, pingpong, frozen, testOn, smoothing.isSettled());
+        (this->*kernel) (left + pos, right + pos,
+                         juce::jmin (subBlockLen, numSamples - pos), ctx);
+    }
+
+    scopeWritePos.store (ctx.scopePos, std::memory_order_relaxed);
+
+    const float inv = 1.f / (float) std::max (1, numSamples);
+    inputLevelL .store (ctx.inAcc  * inv);
+    outputLevelL.store (ctx.outAcc * inv);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Delay time — the RATE knob (× LONG), or the host tempo × SYNC DIV
+// ─────────────────────────────────────────────────────────────────────────────
+float SpaceEchoAudioProcessor::getEffectiveDelayMs (const ParameterSnapshot& snap)
+{
+    if (! snap.getBool (P::sync))  // free rate from knob
+        return snap.get (P::repeatRate) * (snap.getBool (P::longRate) ? P::LONG_RATE_SCALE : 1.f);
+
+    // Ask the host for the current BPM
+    if (auto* ph = getPlayHead())
+    {
+        if (auto pos = ph->getPosition())
+            if (auto bpm = pos->getBpm())
+                lastBpm = *bpm;
+    }
+
+    const int div = juce::jlimit (0, P::NUM_SYNC_DIVS - 1, snap.getInt (P::syncDiv));
+
+    const float delayMs = static_cast<float> (60.0 / lastBpm) * P::SYNC_DIV_BEATS[div] * 1000.f;
+    return juce::jlimit (P::SPECS[P::repeatRate].min, P::MAX_DELAY_MS, delayMs);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Mode — the MODE dial, or TAPS while multiTap is on
+// ─────────────────────────────────────────────────────────────────────────────
+int SpaceEchoAudioProcessor::getModeIndex (const ParameterSnapshot& snap) noexcept
+{
+    // TAPS is its own parameter so that adding it left the dial's
+    // normalised range (and saved automation) untouched
+    if (snap.getBool (P::multiTap))
+        return TAPS_MODE;
+
+    return juce::jlimit (0, TAPS_MODE - 1, snap.getInt (P::mode));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Tail length — time for the loops to decay by 100 dB at current settings
+// ─────────────────────────────────────────────────────────────────────────────
+void SpaceEchoAudioProcessor::updateTailLength (const ParameterSnapshot& snap,
+                                                int modeIndex, bool frozen) noexcept
+{
+    const auto& mode = MODE_TABLE[modeIndex];
+    double tail = 0.0;
+
+    if (mode.hasEcho())
+    {
+        // One pass round the tape loop: intensity × worst-case shelf boost
+        const float  boostDb  = juce::jmax (0.f, snap.get (P::bass), snap.get (P::treble));
+        const double loopGain = snap.get (P::intensity) * juce::Decibels::decibelsToGain ((double) boostDb);
+
+        if (frozen || loopGain >= 1.0)
+        {
+            tailSeconds.store (std::numeric_limits<double>::infinity(), std::memory_order_relaxed);
+            return;
+        }
+
+        float longestRatio = 0.f;
+        for (int h = 0; h < StereoTapeDelay::NUM_HEADS; ++h)
+            if (mode.heads[h])
+                longestRatio = StereoTapeDelay::HEAD_RATIOS[(size_t) h];
+
+        if (mode.taps)
+        {
+            const auto& pattern = tape.getTapPattern();
+            for (int k = 0; k < pattern.numTaps; ++k)
+                longestRatio = juce::jmax (longestRatio, pattern.ratio[(size_t) k]);
+        }
+
+        const double passDelay = smoothing.getTargetValue (DELAY_SLOT) * 0.001 * longestRatio;
+        const double passes    = loopGain > 1.0e-5 ? std::log (1.0e-5) / std::log (loopGain) : 0.0;
+        tail = (passes + 1.0) * passDelay;
+    }
+
+    if (mode.reverb)
+    {
+        // Shimmer re-injects 0.8 × amount of the tail (approximate)
+        const double shimmerGain = 0.8 * snap.get (P::shimmer);
+        tail += springL.getTailSeconds() / (1.0 - shimmerGain);
+
+        // ... each pass through the spectral shifter its latency later
+        if (shimmerEngine == SPECTRAL_SHIMMER && shimmerGain > 1.0e-5)
+            tail += std::log (1.0e-5) / std::log (shimmerGain)
+                    * spectralL.getLatencySamples() / currentSampleRate;
+    }
+
+    tailSeconds.store (tail, std::memory_order_relaxed);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Sleep test — input silent and nothing audible left to recirculate
+// ─────────────────────────────────────────────────────────────────────────────
+bool SpaceEchoAudioProcessor::canSleep (const juce::AudioBuffer<float>& buffer,
+                                        int modeIndex, bool testOn) const noexcept
+{
+    // Hiss and the test tone are generated internally, never silent
+    constexpr auto noiseSlot = static_cast<int> (slot<P::tapeNoise>());
+    if (testOn || smoothing.getCurrentValue (noiseSlot) != 0.f
+               || smoothing.getTargetValue  (noiseSlot) != 0.f)
+        return false;
 
-    // ── Per-sample loop ───────────────────────────────────────────────
-    for (int i = 0; i < buffer.getNumSamples(); ++i)
+    if (! tape.isSilent())
+        return false;
+
+    if (MODE_TABLE[modeIndex].reverb)
     {
-        // Smoothed parameter values — no zipper noise
-        const float gain   = smInputGain  .getNextValue();
-        const float intens = smIntensity  .getNextValue();
-        const float echoLv = smEchoLevel  .getNextValue();
-        const float revLv  = smReverbLevel.getNextValue();
-        const float wow    = smWowFlutter .getNextValue();
-        const float sat    = smSaturation .getNextValue();
-        const float noise  = smTapeNoise  .getNextValue();
-        const float shim   = smShimmer    .getNextValue();
-
-        float inL = left[i]  * gain;
-        float inR = right[i] * gain;
-
-        // ── Test tone ─────────────────────────────────────────────────
-        if (testOn)
+        if (! springL.isSilent() || ! springR.isSilent())
+            return false;
+
+        // The shifter's history only reaches the output while shimmer is up
+        constexpr auto shimmerSlot = static_cast<int> (slot<P::shimmer>());
+        const bool shimmerOff = smoothing.getCurrentValue (shimmerSlot) < 0.001f
+                             && smoothing.getTargetValue  (shimmerSlot) < 0.001f;
+        const bool shimmerSilent = shimmerEngine == SPECTRAL_SHIMMER
+                                       ? spectralL.isSilent() && spectralR.isSilent()
+                                       : shimmerL.isSilent()  && shimmerR.isSilent();
+        if (! shimmerOff && ! shimmerSilent)
+            return false;
+    }
+
+    for (int ch = 0; ch < getTotalNumInputChannels(); ++ch)
+        if (buffer.getMagnitude (ch, 0, buffer.getNumSamples()) > SilenceDetector::THRESHOLD)
+            return false;
+
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Sub-block length — bounded by the shortest feedback path of this block
+// ─────────────────────────────────────────────────────────────────────────────
+int SpaceEchoAudioProcessor::getSubBlockLength() const noexcept
+{
+    // The delay glides between current and target, never outside them
+    const float minDelayMs = std::min (smoothing.getCurrentValue (DELAY_SLOT),
+                                       smoothing.getTargetValue  (DELAY_SLOT));
+    float minDelay = minDelayMs * 0.001f * static_cast<float> (loopSampleRate);
+
+    // Taps can sit closer to the record head than head 1
+    if (MODE_TABLE[lastModeIndex].taps)
+        minDelay *= juce::jmin (1.f, tape.getMinTapRatio());
+
+    // At a reduced loop rate the tape bound is in loop samples, and up to
+    // factor − 1 host samples are still waiting from the previous sub-block
+    const int factor = loopResampler.getFactor();
+
+    return juce::jmin (MAX_SUB_BLOCK,
+                       springL.getPreDelaySamples(),
+                       tape.getMaxBlockLength (minDelay) * factor - (factor - 1));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Kernel dispatch — one entry per (mode, ping-pong, freeze, test tone, settled)
+// ─────────────────────────────────────────────────────────────────────────────
+template <size_t... Index>
+constexpr std::array<SpaceEchoAudioProcessor::SubBlockKernel, sizeof... (Index)>
+SpaceEchoAudioProcessor::makeKernelTable (std::index_sequence<Index...>) noexcept
+{
+    return {{ &SpaceEchoAudioProcessor::processSubBlock<static_cast<int> (Index >> 4),
+                                                        ((Index >> 3) & 1) != 0,
+                                                        ((Index >> 2) & 1) != 0,
+                                                        ((Index >> 1) & 1) != 0,
+                                                        (Index & 1) != 0>... }};
+}
+
+SpaceEchoAudioProcessor::SubBlockKernel
+SpaceEchoAudioProcessor::getKernel (int modeIndex, bool pingpong, bool frozen,
+                                    bool testTone, bool settled) noexcept
+{
+    static constexpr auto kernels = makeKernelTable (std::make_index_sequence<NUM_MODES * 16> {});
+
+    const auto index = (static_cast<size_t> (modeIndex) << 4)
+                     | (pingpong ? 8u : 0u) | (frozen ? 4u : 0u)
+                     | (testTone ? 2u : 0u) | (settled ? 1u : 0u);
+    return kernels[index];
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Sub-block — every stage runs over the whole sub-block in turn
+// ─────────────────────────────────────────────────────────────────────────────
+template <int ModeIndex, bool PingPong, bool Frozen, bool TestTone, bool Settled>
+void SpaceEchoAudioProcessor::processSubBlock (float* left, float* right,
+                                               int n, BlockContext& ctx)
+{
+    static constexpr ModeConfig mode     = MODE_TABLE[ModeIndex];
+    static constexpr unsigned   headMask = mode.headMask();
+    static constexpr int        numHeads = mode.numHeads();
+    static constexpr bool       hasEcho  = mode.hasEcho();
+
+    auto& s = scratch;
+
+    // ── Smoothed parameters — constants when settled, else ramps ──────
+    // (the delay in tape samples, at the loop rate)
+    const float loopRate = static_cast<float> (loopSampleRate);
+
+    if constexpr (! Settled)
+    {
+        smoothing.fillRamps (s.ramps, n);
+
+        for (int i = 0; i < n; ++i)
+            s.delay[i] = s.ramps[DELAY_SLOT][i] * 0.001f * loopRate;
+    }
+
+    const auto delay = [&]
+    {
+        if constexpr (Settled)
+            return ConstantParam { smoothing.getTargetValue (DELAY_SLOT) * 0.001f * loopRate };
+        else
+            return static_cast<const float*> (s.delay.data());
+    }();
+
+    const auto gain        = smoothedParam<Settled, P::inputGain>();
+    const auto intensity   = smoothedParam<Settled, P::intensity>();
+    const auto echoLevel   = smoothedParam<Settled, P::echoLevel>();
+    const auto reverbLevel = smoothedParam<Settled, P::reverbLevel>();
+    const auto wowFlutter  = smoothedParam<Settled, P::wowFlutter>();
+    const auto saturation  = smoothedParam<Settled, P::saturation>();
+    const auto tapeNoise   = smoothedParam<Settled, P::tapeNoise>();
+    const auto shimmer     = smoothedParam<Settled, P::shimmer>();
+
+    // ── Input stage: gain, test tone, tape noise injection ────────────
+    {
+        SPACEECHO_PROFILE_STAGE (profiler, noise);
+
+        for (int i = 0; i < n; ++i)
         {
-            testToneTrigger += 1.f;
-            if (testToneTrigger >= pulseLen)
+            s.inL[i] = left[i]  * gain[i];
+            s.inR[i] = right[i] * gain[i];
+        }
+
+        if constexpr (TestTone)
+        {
+            renderTestTone (s.tapeInL.data(), n); // tapeIn is free until the tape stage
+            for (int i = 0; i < n; ++i)
             {
-                testToneTrigger = 0.f;
-                testTonePhase   = 0.f;
-                testTonePhase2  = 0.f;
+                s.inL[i] += s.tapeInL[i];
+                s.inR[i] += s.tapeInL[i];
             }
-            const float env = (testToneTrigger < 4.f)
-                              ? testToneTrigger * 0.25f
-                              : std::exp (-5.f * testToneTrigger / sr_f);
-            const float s1 = std::sin (testTonePhase  * juce::MathConstants<float>::twoPi);
-            const float s2 = std::sin (testTonePhase2 * juce::MathConstants<float>::twoPi);
-            testTonePhase  += 440.f / sr_f; if (testTonePhase  >= 1.f) testTonePhase  -= 1.f;
-            testTonePhase2 += 554.f / sr_f; if (testTonePhase2 >= 1.f) testTonePhase2 -= 1.f;
-            const float tone = (s1 * 0.6f + s2 * 0.4f) * env * 0.4f;
-            inL += tone; inR += tone;
         }
 
-        // ── Tape noise injection ──────────────────────────────────────
-        inL += noiseL.process (noise);
-        inR += noiseR.process (noise);
+        noiseL.processBlock (s.inL.data(), tapeNoise, n);
+        noiseR.processBlock (s.inR.data(), tapeNoise, n);
+
+        for (int i = 0; i < n; ++i)
+            ctx.inAcc += std::abs (s.inL[i]);
+    }
 
-        inAcc += std::abs (inL);
+    // ── Tape loop: heads, EQ, feedback, record head ───────────────────
+    // numLoop samples at the loop rate: the host rate, or reduced (below)
+    const auto runTapeLoop = [&] (const float* loopInL, const float* loopInR, float* echoL, float* echoR,
+                                  int numLoop, auto loopDelay, auto loopWowFlutter,
+                                  auto loopSaturation, auto loopIntensity)
+    {
+        // ── Playback heads (transport only when none active) ──────────
+        if constexpr (mode.taps)
+        {
+            // Tap bank: already mixed and balanced, straight into the echo buffers
+            SPACEECHO_PROFILE_STAGE (profiler, tape);
+            float* taps[] = { echoL, echoR };
+            tape.readTaps (taps, loopDelay, loopWowFlutter, numLoop);
+        }
+        else
+        {
+            SPACEECHO_PROFILE_STAGE (profiler, tape);
+            StereoTapeDelay::HeadBuffers heads;
+            for (int h = 0; h < StereoTapeDelay::NUM_HEADS; ++h)
+            {
+                heads[0][(size_t) h] = s.headsL[(size_t) h].data();
+                heads[1][(size_t) h] = s.headsR[(size_t) h].data();
+            }
 
-        // ── Tape delay ────────────────────────────────────────────────
-        const float baseDelay = smSyncDelay.getNextValue()
-                                * 0.001f * static_cast<float> (currentSampleRate);
-        auto headsL = tapeL.process (inL, baseDelay, feedbackL, wow, sat);
-        auto headsR = tapeR.process (inR, baseDelay, feedbackR, wow, sat);
+            tape.readBlock<headMask> (heads, loopDelay, loopWowFlutter, numLoop);
+        }
 
-        // ── Sum active heads ──────────────────────────────────────────
-        float echoL = 0.f, echoR = 0.f;
-        for (int h = 0; h < TapeDelay::NUM_HEADS; ++h)
+        if constexpr (hasEcho)
         {
-            if (mc.heads[h])
+            SPACEECHO_PROFILE_STAGE (profiler, eq);
+
+            // ── Sum active heads ──────────────────────────────────────
+            if constexpr (numHeads > 0)
+            {
+                std::fill_n (echoL, numLoop, 0.f);
+                std::fill_n (echoR, numLoop, 0.f);
+
+                for (int h = 0; h < StereoTapeDelay::NUM_HEADS; ++h)
+                {
+                    if (! mode.heads[h])
+                        continue;
+
+                    for (int i = 0; i < numLoop; ++i)
+                    {
+                        echoL[i] += s.headsL[(size_t) h][i];
+                        echoR[i] += s.headsR[(size_t) h][i];
+                    }
+                }
+
+                for (int i = 0; i < numLoop; ++i)
+                {
+                    echoL[i] /= (float) numHeads;
+                    echoR[i] /= (float) numHeads;
+                }
+            }
+
+            // ── EQ on echo feedback path ──────────────────────────────
+            for (int i = 0; i < numLoop; ++i)
             {
-                echoL += headsL.heads[h];
-                echoR += headsR.heads[h];
+                echoL[i] = trebleL.processSample (bassL.processSample (echoL[i]));
+                echoR[i] = trebleR.processSample (bassR.processSample (echoR[i]));
             }
         }
-        if (numHeads > 0)
+
+        // ── Feedback (with optional ping-pong) → record head ──────────
+        // One-sample feedback: sample i records the echo of sample i − 1
+        // (plus the resampling latency at a reduced loop rate).
+        // Frozen: nothing is recorded, only the last feedback sample matters.
+        SPACEECHO_PROFILE_STAGE (profiler, tape);
+        const float* fbEchoL = echoL;
+        const float* fbEchoR = echoR;
+
+        if constexpr (hasEcho)
         {
-            echoL /= (float) numHeads;
-            echoR /= (float) numHeads;
+            if (loopResampler.getLatency() > 0)
+            {
+                const float* echo[]    = { echoL, echoR };
+                float*       delayed[] = { s.loopFeedbackL.data(), s.loopFeedbackR.data() };
+                loopResampler.delayFeedback (echo, delayed, numLoop);
+                fbEchoL = delayed[0];
+                fbEchoR = delayed[1];
+            }
         }
 
-        // ── EQ on echo feedback path ──────────────────────────────────
-        echoL = bassL.processSample   (echoL);
-        echoL = trebleL.processSample (echoL);
-        echoR = bassR.processSample   (echoR);
-        echoR = trebleR.processSample (echoR);
+        const float* fbSrcL = PingPong ? fbEchoR : fbEchoL;
+        const float* fbSrcR = PingPong ? fbEchoL : fbEchoR;
 
-        // ── Feedback (with optional ping-pong) ────────────────────────
-        if (pingpong)
+        if constexpr (Frozen)
         {
-            feedbackL = echoR * intens;
-            feedbackR = echoL * intens;
+            juce::ignoreUnused (loopInL, loopInR, loopSaturation);
+
+            if constexpr (hasEcho)
+            {
+                feedbackL = fbSrcL[numLoop - 1] * loopIntensity[numLoop - 1];
+                feedbackR = fbSrcR[numLoop - 1] * loopIntensity[numLoop - 1];
+            }
+            else
+            {
+                feedbackL = feedbackR = 0.f;
+            }
+
+            tape.skipBlock (numLoop);
         }
         else
         {
-            feedbackL = echoL * intens;
-            feedbackR = echoR * intens;
+            if constexpr (hasEcho)
+            {
+                for (int i = 0; i < numLoop; ++i)
+                {
+                    s.tapeInL[i] = loopInL[i] + feedbackL;
+                    s.tapeInR[i] = loopInR[i] + feedbackR;
+                    feedbackL = fbSrcL[i] * loopIntensity[i];
+                    feedbackR = fbSrcR[i] * loopIntensity[i];
+                }
+            }
+            else
+            {
+                // No echo: only the feedback left over from the previous mode
+                for (int i = 0; i < numLoop; ++i)
+                {
+                    s.tapeInL[i] = loopInL[i] + feedbackL;
+                    s.tapeInR[i] = loopInR[i] + feedbackR;
+                    feedbackL = feedbackR = 0.f;
+                }
+            }
+
+            const float* tapeIn[] = { s.tapeInL.data(), s.tapeInR.data() };
+            tape.writeBlock (tapeIn, loopSaturation, numLoop);
         }
+    };
 
-        // ── Spring reverb + shimmer feedback loop ─────────────────────
-        // Architecture: reverb feeds into pitch shifter, pitch shifter
-        // feeds back into reverb — creates an endless rising shimmer.
-        float revL = 0.f, revR = 0.f;
-        if (mc.reverb)
+    if (loopResampler.getFactor() == 1)
+    {
+        runTapeLoop (s.inL.data(), s.inR.data(), s.echoL.data(), s.echoR.data(), n,
+                     delay, wowFlutter, saturation, intensity);
+    }
+    else
+    {
+        // Reduced loop rate: only the loop's input and echo are resampled,
+        // the dry path, springs and output stay at the host rate
+        const float* hostIn[] = { s.inL.data(), s.inR.data() };
+        float*       loopIn[] = { s.loopInL.data(), s.loopInR.data() };
+        const int numLoop = loopResampler.decimate (hostIn, n, loopIn);
+
+        // Per-sample parameters: every factor-th host value
+        const int factor = loopResampler.getFactor();
+        const auto atLoopRate = [&] (auto param, SubBlockBuffer& dest)
         {
-            revL = springL.process (inL + echoL * 0.15f + shimFeedL);
-            revR = springR.process (inR + echoR * 0.15f + shimFeedR);
+            if constexpr (Settled)
+            {
+                return param;
+            }
+            else
+            {
+                for (int j = 0; j < numLoop; ++j)
+                    dest[(size_t) j] = param[juce::jmin (j * factor, n - 1)];
+                return static_cast<const float*> (dest.data());
+            }
+        };
 
-            // Update shimmer feedback (granular +1 oct pitch shifted reverb)
-            shimFeedL = shimmerL.process (revL, shim) * 0.8f;
-            shimFeedR = shimmerR.process (revR, shim) * 0.8f;
+        if constexpr (! hasEcho)
+        {
+            std::fill_n (s.loopEchoL.begin(), numLoop, 0.f);
+            std::fill_n (s.loopEchoR.begin(), numLoop, 0.f);
         }
-        else
+
+        if (numLoop > 0)
+            runTapeLoop (s.loopInL.data(), s.loopInR.data(), s.loopEchoL.data(), s.loopEchoR.data(), numLoop,
+                         atLoopRate (delay,      s.loopDelay),
+                         atLoopRate (wowFlutter, s.loopWowFlutter),
+                         atLoopRate (saturation, s.loopSaturation),
+                         atLoopRate (intensity,  s.loopIntensity));
+
+        const float* loopEcho[] = { s.loopEchoL.data(), s.loopEchoR.data() };
+        float*       hostEcho[] = { s.echoL.data(), s.echoR.data() };
+        loopResampler.interpolate (loopEcho, numLoop, hostEcho, n);
+    }
+
+    // ── Spring reverb + shimmer feedback loop ─────────────────────────
+    // Architecture: reverb feeds into pitch shifter, pitch shifter
+    // feeds back into reverb — creates an endless rising shimmer.
+    if constexpr (mode.reverb)
+    {
+        // Tank output only depends on pre-delayed input → render first
+        {
+            SPACEECHO_PROFILE_STAGE (profiler, reverb);
+            springL.readBlock (s.revL.data(), n);
+            springR.readBlock (s.revR.data(), n);
+        }
+
+        // Pitch shift of the reverb to the voicing (springIn used as
+        // scratch): granular, or spectral getLatencySamples() later
         {
-            shimFeedL = shimFeedR = 0.f;
+            SPACEECHO_PROFILE_STAGE (profiler, shimmer);
+            std::copy_n (s.revL.begin(), n, s.springInL.begin());
+            std::copy_n (s.revR.begin(), n, s.springInR.begin());
+            if (shimmerEngine == SPECTRAL_SHIMMER)
+            {
+                spectralL.processBlock (s.springInL.data(), shimmer, n);
+                spectralR.processBlock (s.springInR.data(), shimmer, n);
+            }
+            else
+            {
+                shimmerL.processBlock (s.springInL.data(), shimmer, n);
+                shimmerR.processBlock (s.springInR.data(), shimmer, n);
+            }
+        }
+
+        SPACEECHO_PROFILE_STAGE (profiler, reverb);
+
+        // Reverb input = dry + echo send + one-sample-late shimmer feedback
+        for (int i = 0; i < n; ++i)
+        {
+            const float shimOutL = s.springInL[i];
+            const float shimOutR = s.springInR[i];
+            if constexpr (hasEcho)
+            {
+                s.springInL[i] = s.inL[i] + s.echoL[i] * 0.15f + shimFeedL;
+                s.springInR[i] = s.inR[i] + s.echoR[i] * 0.15f + shimFeedR;
+            }
+            else
+            {
+                s.springInL[i] = s.inL[i] + shimFeedL;
+                s.springInR[i] = s.inR[i] + shimFeedR;
+            }
+            shimFeedL = shimOutL * 0.8f;
+            shimFeedR = shimOutR * 0.8f;
         }
 
-        // ── Output mix ────────────────────────────────────────────────
-        const float mixL = inL + echoL * echoLv + revL * revLv;
-        const float mixR = inR + echoR * echoLv + revR * revLv;
+        springL.writeBlock (s.springInL.data(), n);
+        springR.writeBlock (s.springInR.data(), n);
+    }
+    else
+    {
+        shimFeedL = shimFeedR = 0.f;
+    }
 
-        // ── Soft limiter (transparent below 0 dBFS, prevents digital clip) ──
-        const float outL = softClip (mixL);
-        const float outR = softClip (mixR);
+    // ── Output mix + soft limiter (transparent below 0 dBFS) ──────────
+    SPACEECHO_PROFILE_STAGE (profiler, output);
 
-        left[i]  = outL;
-        right[i] = outR;
-        outAcc  += std::abs (outL);
+    for (int i = 0; i < n; ++i)
+    {
+        float mixL = s.inL[i];
+        float mixR = s.inR[i];
 
-        // ── Oscilloscope ──────────────────────────────────────────────
-        scopeBuffer[scopePos] = outL;
-        scopePos = (scopePos + 1) % SCOPE_SIZE;
+        if constexpr (hasEcho)
+        {
+            mixL += s.echoL[i] * echoLevel[i];
+            mixR += s.echoR[i] * echoLevel[i];
+        }
+
+        if constexpr (mode.reverb)
+        {
+            mixL += s.revL[i] * reverbLevel[i];
+            mixR += s.revR[i] * reverbLevel[i];
+        }
+
+        left[i]  = mixL;
+        right[i] = mixR;
+    }
+
+    {
+        // (mono: right aliases left — clip it once)
+        float* out[] = { left, right };
+        outputOversampler.process (out, n, [] (float* const* io, int numSamples)
+        {
+            const int numChannels = io[1] == io[0] ? 1 : 2;
+            for (int c = 0; c < numChannels; ++c)
+                for (int i = 0; i < numSamples; ++i)
+                    io[c][i] = softClip (io[c][i]);
+        });
     }
 
-    scopeWritePos.store (scopePos, std::memory_order_relaxed);
+    for (int i = 0; i < n; ++i)
+        ctx.outAcc += std::abs (left[i]);
 
-    const float inv = 1.f / (float) std::max (1, buffer.getNumSamples());
-    inputLevelL .store (inAcc  * inv);
-    outputLevelL.store (outAcc * inv);
+    // ── Oscilloscope ──────────────────────────────────────────────────
+    for (int i = 0; i < n; ++i)
+    {
+        scopeBuffer[ctx.scopePos] = left[i];
+        ctx.scopePos = (ctx.scopePos + 1) % SCOPE_SIZE;
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Test tone — 440 + 554 Hz ping every 1.5 s
+// ─────────────────────────────────────────────────────────────────────────────
+void SpaceEchoAudioProcessor::renderTestTone (float* dest, int numSamples) noexcept
+{
+    const float sr_f     = (float) currentSampleRate;
+    const float pulseLen = sr_f * 1.5f;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        testToneTrigger += 1.f;
+        if (testToneTrigger >= pulseLen)
+        {
+            testToneTrigger = 0.f;
+            testTonePhase   = 0.f;
+            testTonePhase2  = 0.f;
+        }
+        const float env = (testToneTrigger < 4.f)
+                          ? testToneTrigger * 0.25f
+                          : std::exp (-5.f * testToneTrigger / sr_f);
+        const float s1 = std::sin (testTonePhase  * juce::MathConstants<float>::twoPi);
+        const float s2 = std::sin (testTonePhase2 * juce::MathConstants<float>::twoPi);
+        testTonePhase  += 440.f / sr_f; if (testTonePhase  >= 1.f) testTonePhase  -= 1.f;
+        testTonePhase2 += 554.f / sr_f; if (testTonePhase2 >= 1.f) testTonePhase2 -= 1.f;
+        dest[i] = (s1 * 0.6f + s2 * 0.4f) * env * 0.4f;
+    }
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -418,7 +935,212 @@ void SpaceEchoAudioProcessor::setStateInformation (const void* data, int sizeInB
 {
     std::unique_ptr<juce::XmlElement> xml (getXmlFromBinary (data, sizeInBytes));
     if (xml && xml->hasTagName (apvts.state.getType()))
+    {
         apvts.replaceState (juce::ValueTree::fromXml (*xml));
+        publishTapPattern (getTapPattern());
+        restoreSpringImpulseResponse();
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Engine settings — stored with the state, applied by prepareToPlay
+// ─────────────────────────────────────────────────────────────────────────────
+void SpaceEchoAudioProcessor::setCompactTapeStorage (bool shouldBeCompact)
+{
+    apvts.state.setProperty (COMPACT_TAPE_ID, shouldBeCompact, nullptr);
+}
+
+bool SpaceEchoAudioProcessor::isCompactTapeStorage() const
+{
+    return apvts.state.getProperty (COMPACT_TAPE_ID, false);
+}
+
+void SpaceEchoAudioProcessor::setReducedLoopRate (bool shouldReduce)
+{
+    apvts.state.setProperty (REDUCED_LOOP_RATE_ID, shouldReduce, nullptr);
+}
+
+bool SpaceEchoAudioProcessor::isReducedLoopRate() const
+{
+    return apvts.state.getProperty (REDUCED_LOOP_RATE_ID, false);
+}
+
+void SpaceEchoAudioProcessor::setRandomSeed (uint32_t seed)
+{
+    // ValueTree ints are signed: stored as the same 32 bits
+    apvts.state.setProperty (RANDOM_SEED_ID, static_cast<int> (seed), nullptr);
+}
+
+uint32_t SpaceEchoAudioProcessor::getRandomSeed() const
+{
+    return static_cast<uint32_t> (static_cast<int> (apvts.state.getProperty (RANDOM_SEED_ID, 0)));
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Multi-tap pattern — state property, handed to the audio thread per block
+// ─────────────────────────────────────────────────────────────────────────────
+void SpaceEchoAudioProcessor::setTapPattern (const TapPattern& pattern)
+{
+    apvts.state.setProperty (TAP_PATTERN_ID, tapPatternToString (pattern), nullptr);
+    publishTapPattern (pattern);
+}
+
+SpaceEchoAudioProcessor::TapPattern SpaceEchoAudioProcessor::getTapPattern() const
+{
+    const auto text = apvts.state.getProperty (TAP_PATTERN_ID).toString();
+    return text.isEmpty() ? getDefaultTapPattern() : tapPatternFromString (text);
+}
+
+SpaceEchoAudioProcessor::TapPattern SpaceEchoAudioProcessor::getDefaultTapPattern() noexcept
+{
+    // Dotted-eighth style rhythm, bouncing across the stereo field
+    TapPattern pattern;
+    pattern.numTaps = 4;
+    pattern.ratio   = { 0.25f, 0.5f, 0.75f, 1.0f };
+    pattern.level   = { 1.0f,  0.8f, 0.6f,  0.45f };
+    pattern.pan     = { -0.6f, 0.6f, -0.3f, 0.3f };
+    return pattern;
+}
+
+juce::String SpaceEchoAudioProcessor::tapPatternToString (const TapPattern& pattern)
+{
+    juce::StringArray taps;
+    for (int k = 0; k < juce::jlimit (1, StereoTapeDelay::MAX_TAPS, pattern.numTaps); ++k)
+        taps.add (juce::String (pattern.ratio[(size_t) k], 4) + " "
+                  + juce::String (pattern.level[(size_t) k], 3) + " "
+                  + juce::String (pattern.pan[(size_t) k], 3));
+    return taps.joinIntoString ("; ");
+}
+
+SpaceEchoAudioProcessor::TapPattern SpaceEchoAudioProcessor::tapPatternFromString (const juce::String& text)
+{
+    TapPattern pattern;
+    pattern.numTaps = 0;
+
+    for (const auto& tap : juce::StringArray::fromTokens (text, ";", {}))
+    {
+        const auto fields = juce::StringArray::fromTokens (tap.trim(), " ", {});
+        if (fields.size() < 1 || pattern.numTaps == StereoTapeDelay::MAX_TAPS)
+            continue;
+
+        const auto k = (size_t) pattern.numTaps++;
+        pattern.ratio[k] = fields[0].getFloatValue();
+        pattern.level[k] = fields.size() > 1 ? fields[1].getFloatValue() : 1.f;
+        pattern.pan[k]   = fields.size() > 2 ? fields[2].getFloatValue() : 0.f;
+    }
+
+    return pattern.numTaps > 0 ? pattern : getDefaultTapPattern();
+}
+
+void SpaceEchoAudioProcessor::publishTapPattern (const TapPattern& pattern)
+{
+    const juce::SpinLock::ScopedLockType lock (tapPatternLock);
+    pendingTapPattern = pattern;
+    tapPatternPending.store (true);
+}
+
+void SpaceEchoAudioProcessor::applyPendingTapPattern() noexcept
+{
+    if (! tapPatternPending.load())
+        return;
+
+    // Never waits: a pattern being written is picked up next block
+    const juce::SpinLock::ScopedTryLockType lock (tapPatternLock);
+    if (lock.isLocked())
+    {
+        tape.setTapPattern (pendingTapPattern);
+        tapPatternPending.store (false);
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  Spring impulse response — file path in the state, partitions in the springs
+// ─────────────────────────────────────────────────────────────────────────────
+bool SpaceEchoAudioProcessor::setSpringImpulseResponse (const juce::File& file)
+{
+    if (file == juce::File())
+        springIr.setSize (0, 0);
+    else if (! readSpringImpulseResponse (file))
+        return false;
+
+    apvts.state.setProperty (SPRING_IR_ID, file.getFullPathName(), nullptr);
+    installSpringImpulseResponse();
+    updateWorkerThreads();
+    return true;
+}
+
+juce::File SpaceEchoAudioProcessor::getSpringImpulseResponse() const
+{
+    const auto path = apvts.state.getProperty (SPRING_IR_ID).toString();
+    return juce::File::isAbsolutePath (path) ? juce::File (path) : juce::File();
+}
+
+bool SpaceEchoAudioProcessor::readSpringImpulseResponse (const juce::File& file)
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (file));
+    if (reader == nullptr || reader->lengthInSamples <= 0)
+        return false;
+
+    const auto maxLength = static_cast<juce::int64> (SpringConvolver::MAX_SECONDS * reader->sampleRate) + 1;
+    const auto length    = static_cast<int> (juce::jmin (reader->lengthInSamples, maxLength));
+
+    springIr.setSize (juce::jmin (2, static_cast<int> (reader->numChannels)), length);
+    reader->read (&springIr, 0, length, 0, true, springIr.getNumChannels() > 1);
+    springIrRate = reader->sampleRate;
+    return true;
+}
+
+void SpaceEchoAudioProcessor::restoreSpringImpulseResponse()
+{
+    // A missing file leaves the path in the state and the engine on its fallback
+    const auto file = getSpringImpulseResponse();
+    if (file == juce::File() || ! readSpringImpulseResponse (file))
+        springIr.setSize (0, 0);
+
+    installSpringImpulseResponse();
+    updateWorkerThreads();
+}
+
+void SpaceEchoAudioProcessor::installSpringImpulseResponse()
+{
+    if (springIr.getNumSamples() == 0)
+    {
+        springL.setImpulseResponse (nullptr, 0);
+        springR.setImpulseResponse (nullptr, 0);
+        return;
+    }
+
+    // Resample to the tank rate (the interpolator reads a few samples ahead)
+    const double ratio  = springIrRate / springL.getTankSampleRate();
+    const int    length = static_cast<int> (std::ceil (springIr.getNumSamples() / ratio));
+
+    juce::AudioBuffer<float> ir (springIr.getNumChannels(), length);
+    std::vector<float> padded;
+
+    for (int c = 0; c < ir.getNumChannels(); ++c)
+    {
+        padded.assign (springIr.getReadPointer (c), springIr.getReadPointer (c) + springIr.getNumSamples());
+        padded.resize (padded.size() + 8, 0.f);
+
+        juce::LagrangeInterpolator resampler;
+        resampler.process (ratio, padded.data(), ir.getWritePointer (c), length);
+    }
+
+    // Same impulse energy as the Schroeder tank, averaged over the channels
+    double energy = 0.0;
+    for (int c = 0; c < ir.getNumChannels(); ++c)
+        for (int i = 0; i < length; ++i)
+            energy += juce::square ((double) ir.getSample (c, i));
+    energy /= ir.getNumChannels();
+
+    if (energy > 0.0)
+        ir.applyGain (static_cast<float> (std::sqrt (SPRING_IR_ENERGY / energy)));
+
+    springL.setImpulseResponse (ir.getReadPointer (0), length);
+    springR.setImpulseResponse (ir.getReadPointer (ir.getNumChannels() - 1), length);
 }
 
 // ─────────────────────────────────────────────────────────────────────────────
@@ -1,27 +1,78 @@
 #pragma once
 #include <JuceHeader.h>
+#include "ParameterRegistry.h"
+#include "SmoothingEngine.h"
+#include "StageProfiler.h"
 #include "DSP/TapeDelay.h"
+#include "DSP/LoopResampler.h"
 #include "DSP/SpringReverb.h"
 #include "DSP/TapeNoise.h"
 #include "DSP/ShimmerChorus.h"
+#include "DSP/SpectralShimmer.h"
 #include <array>
 #include <atomic>
+#include <utility>
 
-class SpaceEchoAudioProcessor : public juce::AudioProcessor
+class SpaceEchoAudioProcessor : public juce::AudioProcessor,
+                                private juce::AsyncUpdater
 {
 public:
     // ── Mode table ──────────────────────────────────────────────────────
     struct ModeConfig
     {
-        bool heads[TapeDelay::NUM_HEADS];
+        bool heads[StereoTapeDelay::NUM_HEADS];
         bool reverb;
+        bool taps = false; // multi-tap bank (setTapPattern) instead of the heads
+
+        constexpr unsigned headMask() const noexcept
+        {
+            unsigned mask = 0;
+            for (int h = 0; h < StereoTapeDelay::NUM_HEADS; ++h)
+                if (heads[h]) mask |= 1u << h;
+            return mask;
+        }
+
+        constexpr int numHeads() const noexcept
+        {
+            int n = 0;
+            for (int h = 0; h < StereoTapeDelay::NUM_HEADS; ++h)
+                if (heads[h]) ++n;
+            return n;
+        }
+
+        /** Something is played back from the tape (heads or taps). */
+        constexpr bool hasEcho() const noexcept { return taps || numHeads() > 0; }
     };
 
-    static const ModeConfig MODE_TABLE[12];
+    static constexpr int NUM_MODES = 13;
+    static constexpr int TAPS_MODE = NUM_MODES - 1; // multiTap parameter, not a `mode` value
+
+    static constexpr ModeConfig MODE_TABLE[NUM_MODES] =
+    {
+        {{ true,  false, false }, false }, // 1  – H1
+        {{ false,  true, false }, false }, // 2  – H2
+        {{ false, false,  true }, false }, // 3  – H3
+        {{ true,   true, false }, false }, // 4  – H1+H2
+        {{ true,  false,  true }, false }, // 5  – H1+H3
+        {{ false,  true,  true }, false }, // 6  – H2+H3
+        {{ true,   true,  true }, false }, // 7  – ALL
+        {{ true,  false, false },  true }, // 8  – H1+Reverb
+        {{ false,  true, false },  true }, // 9  – H2+Reverb
+        {{ false, false,  true },  true }, // 10 – H3+Reverb
+        {{ true,   true,  true },  true }, // 11 – ALL+Reverb
+        {{ false, false, false },  true }, // 12 – Reverb only
+        {{ false, false, false }, false, true }, // 13 – TAPS
+    };
 
     // ── Oscilloscope ring buffer size ─────────────────────────────────
     static constexpr int SCOPE_SIZE = 512;
 
+    // ── Sub-block pipeline ────────────────────────────────────────────
+    // Each stage runs over a whole sub-block before the next one starts.
+    // Sub-blocks are further capped by the shortest feedback path (spring
+    // pre-delay, tape head 1) so loops can be evaluated stage by stage.
+    static constexpr int MAX_SUB_BLOCK = 256;
+
     // ── Construction ──────────────────────────────────────────────────
     SpaceEchoAudioProcessor();
     ~SpaceEchoAudioProcessor() override;
@@ -29,6 +80,7 @@ public:
     // ── AudioProcessor interface ──────────────────────────────────────
     void prepareToPlay  (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    void setNonRealtime (bool isNonRealtime) noexcept override;
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
@@ -39,7 +91,7 @@ public:
     bool acceptsMidi()   const override { return false; }
     bool producesMidi()  const override { return false; }
     bool isMidiEffect()  const override { return false; }
-    double getTailLengthSeconds() const override { return 3.0; }
+    double getTailLengthSeconds() const override { return tailSeconds.load (std::memory_order_relaxed); }
 
     int  getNumPrograms()               override { return 1; }
     int  getCurrentProgram()            override { return 0; }
@@ -54,6 +106,54 @@ public:
     juce::AudioProcessorValueTreeState apvts;
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    /** Cached parameter atomics — use instead of string lookups. */
+    const ParameterRegistry& getParameterRegistry() const noexcept { return params; }
+
+    // ── Engine settings (state properties, not automatable) ─────────
+    // Saved with the plugin state; they reallocate, so they take effect at
+    // the next prepareToPlay.
+    static constexpr const char* COMPACT_TAPE_ID      = "compactTape";     // int16 tape storage
+    static constexpr const char* REDUCED_LOOP_RATE_ID = "reducedLoopRate"; // tape loop at ~48 kHz
+    static constexpr const char* RANDOM_SEED_ID       = "randomSeed";      // flutter, dropouts, hiss
+
+    void setCompactTapeStorage (bool shouldBeCompact);
+    bool isCompactTapeStorage() const;
+
+    /** At 88.2 kHz and up, run the tape loop (heads, EQ, feedback, record
+        head) at the host rate ÷ 2 or 4, no lower than 44.1 kHz. */
+    void setReducedLoopRate (bool shouldReduce);
+    bool isReducedLoopRate() const;
+
+    /** Seed of every random generator (RandomSeed; 0 = the historical sound).
+        Same input + state + seed → bit-identical output from prepareToPlay on. */
+    void     setRandomSeed (uint32_t seed);
+    uint32_t getRandomSeed() const;
+
+    // ── Multi-tap pattern (mode 13) ─────────────────────────────────
+    // Saved with the plugin state; applied at the start of the next block,
+    // taps glide to their new positions and levels.
+    static constexpr const char* TAP_PATTERN_ID = "tapPattern"; // "ratio level pan; …"
+
+    using TapPattern = StereoTapeDelay::TapPattern;
+
+    void       setTapPattern (const TapPattern& pattern);
+    TapPattern getTapPattern() const;
+
+    static TapPattern   getDefaultTapPattern() noexcept;
+    static juce::String tapPatternToString   (const TapPattern& pattern);
+    static TapPattern   tapPatternFromString (const juce::String& text);
+
+    // ── Spring impulse response (reverb engine "IR") ────────────────
+    // Saved with the plugin state as a file path.  Decoded and partitioned
+    // on the calling thread; the audio thread swaps it in without a gap.
+    static constexpr const char* SPRING_IR_ID = "springIR"; // absolute path
+
+    /** Loads a WAV / AIFF spring-tank response (up to SpringConvolver::MAX_SECONDS);
+        an empty File unloads it.  False if the file cannot be read — the
+        current response stays. */
+    bool       setSpringImpulseResponse (const juce::File& file);
+    juce::File getSpringImpulseResponse() const;
+
     // ── Metering ──────────────────────────────────────────────────────
     float getInputLevel()  const noexcept { return inputLevelL.load(); }
     float getOutputLevel() const noexcept { return outputLevelL.load(); }
@@ -67,12 +167,19 @@ public:
     int          getScopeWritePos() const noexcept
         { return scopeWritePos.load (std::memory_order_relaxed); }
 
+    // ── Per-stage timing (diagnostics overlay, SPACEECHO_PROFILING) ──
+    StageProfiler&       getProfiler()       noexcept { return profiler; }
+    const StageProfiler& getProfiler() const noexcept { return profiler; }
+
 private:
+    ParameterRegistry params;
+
     // ── DSP objects ───────────────────────────────────────────────────
-    TapeDelay    tapeL, tapeR;
+    StereoTapeDelay tape;             // L/R tape loops, one SIMD lane each
     SpringReverb springL, springR;
     TapeNoise    noiseL, noiseR;
-    ShimmerChorus shimmerL, shimmerR; // granular +1-octave pitch shifter
+    ShimmerChorus shimmerL, shimmerR; // granular pitch shifter, one grain buffer per side
+    SpectralShimmer spectralL, spectralR; // phase vocoder, any voicing (worker thread)
 
     // IIR shelving EQ (inside feedback path)
     juce::dsp::IIR::Filter<float> bassL,   bassR;
@@ -86,20 +193,52 @@ private:
     // Shimmer feedback (pitch-shifted reverb tail fed back into reverb input)
     float shimFeedL = 0.f, shimFeedR = 0.f;
 
+    // Shimmer pitch shifter in use (shimmerEngine) and the voicing given to
+    // both (shimmerVoicing); −1 = none applied yet
+    static constexpr int SPECTRAL_SHIMMER = 1;
+    int shimmerEngine  = -1;
+    int shimmerVoicing = -1;
+
     double currentSampleRate = 44100.0;
 
+    // ── Tape loop rate (reducedLoopRate) ─────────────────────────────
+    // The loop runs at loopSampleRate; when that is below the host rate
+    // only its input and echo output are resampled.
+    static constexpr double MIN_LOOP_RATE = 44100.0;
+
+    LoopResampler<2> loopResampler;
+    double           loopSampleRate = 44100.0;
+
+    // ── Oversampled output soft clip (latency reported to the host) ──
+    HalfbandOversampler<2> outputOversampler;
+    int oversamplingLog2 = -1;          // applied setting, −1 = none yet
+    std::atomic<int> outputLatency { 0 }; // its latency, reported on the message thread
+
     // ── Per-sample parameter smoothing (eliminates zipper noise) ─────
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> smInputGain;
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> smIntensity;
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> smEchoLevel;
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> smReverbLevel;
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> smWowFlutter;
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> smSaturation;
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> smTapeNoise;
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> smShimmer;
-
-    // Smoothed delay time — used by tempo-sync to glide between divisions
-    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> smSyncDelay;
+    // One ramp per ParameterRegistry::SMOOTHED entry, plus the delay time
+    // (DELAY_SLOT) — used by tempo-sync to glide between divisions
+    static constexpr int DELAY_SLOT = ParameterRegistry::NUM_SMOOTHED;
+    SmoothingEngine<ParameterRegistry::NUM_SMOOTHED + 1> smoothing;
+
+    // ── Tap pattern hand-over (message thread → audio thread) ────────
+    juce::SpinLock    tapPatternLock;
+    TapPattern        pendingTapPattern;
+    std::atomic<bool> tapPatternPending { false };
+
+    void publishTapPattern (const TapPattern& pattern);
+    void applyPendingTapPattern() noexcept;
+
+    // ── Spring impulse response, decoded at its file rate ────────────
+    // Resampled and normalised to the Schroeder tank's impulse energy
+    // at the fixed reverb size whenever it is (re)installed.
+    static constexpr double SPRING_IR_ENERGY = 4.8;
+
+    juce::AudioBuffer<float> springIr;
+    double                   springIrRate = 0.0;
+
+    bool readSpringImpulseResponse (const juce::File& file);
+    void restoreSpringImpulseResponse();
+    void installSpringImpulseResponse();
 
     // ── Tempo sync state ──────────────────────────────────────────────
     double lastBpm = 120.0; // last known host BPM (kept across blocks)
@@ -118,8 +257,96 @@ private:
     std::array<float, SCOPE_SIZE> scopeBuffer = {};
     std::atomic<int>              scopeWritePos { 0 };
 
+    // ── Stage timing ──────────────────────────────────────────────────
+    StageProfiler profiler;
+
+    // ── Sub-block scratch (one buffer per stage signal) ───────────────
+    using SubBlockBuffer = std::array<float, MAX_SUB_BLOCK>;
+
+    struct SubBlockScratch
+    {
+        // Smoothed parameter ramps (indexed by smoothed slot, delay glide in
+        // ms at DELAY_SLOT) + delay glide in tape samples
+        std::array<SubBlockBuffer, ParameterRegistry::NUM_SMOOTHED + 1> ramps;
+        SubBlockBuffer delay;
+
+        // Signal path
+        SubBlockBuffer inL, inR, echoL, echoR, revL, revR;
+        SubBlockBuffer tapeInL, tapeInR, springInL, springInR;
+        std::array<SubBlockBuffer, StereoTapeDelay::NUM_HEADS> headsL, headsR;
+
+        // Tape loop at a reduced rate: its input, echo, delayed feedback and
+        // the loop's per-sample parameters
+        SubBlockBuffer loopInL, loopInR, loopEchoL, loopEchoR, loopFeedbackL, loopFeedbackR;
+        SubBlockBuffer loopDelay, loopWowFlutter, loopSaturation, loopIntensity;
+    };
+
+    SubBlockScratch scratch;
+
+    /** Running accumulators shared by all sub-blocks of a block. */
+    struct BlockContext
+    {
+        float inAcc    = 0.f;
+        float outAcc   = 0.f;
+        int   scopePos = 0;
+    };
+
+    /** Smoother / ramp slot of a smoothed parameter (checked at compile time). */
+    template <ParameterRegistry::Param p>
+    static constexpr size_t slot() noexcept
+    {
+        constexpr int s = ParameterRegistry::smoothedSlot (p);
+        static_assert (s >= 0, "parameter has no smoothing policy");
+        return static_cast<size_t> (s);
+    }
+
+    /** Per-sample accessor of a smoothed parameter for the current sub-block:
+        its target while settled, its ramp buffer otherwise. */
+    template <bool Settled, ParameterRegistry::Param p>
+    auto smoothedParam() const noexcept
+    {
+        if constexpr (Settled)
+            return ConstantParam { smoothing.getTargetValue (static_cast<int> (slot<p>())) };
+        else
+            return static_cast<const float*> (scratch.ramps[slot<p>()].data());
+    }
+
     // ── Helpers ───────────────────────────────────────────────────────
     void updateEQ (float bassDb, float trebleDb);
+    bool applyOversampling (int factorLog2) noexcept;
+    void handleAsyncUpdate() override;
+    void updateWorkerThreads();
+    void applyShimmerSettings (int engine, int voicing) noexcept;
+    float getEffectiveDelayMs (const ParameterSnapshot& snap);
+    static int getModeIndex (const ParameterSnapshot& snap) noexcept;
+    void updateTailLength (const ParameterSnapshot& snap, int modeIndex, bool frozen) noexcept;
+    bool canSleep (const juce::AudioBuffer<float>& buffer, int modeIndex, bool testOn) const noexcept;
+    int  getSubBlockLength() const noexcept;
+    void renderTestTone (float* dest, int numSamples) noexcept;
+
+    // ── Mode-specialised sub-block kernels ────────────────────────────
+    // One instantiation per MODE_TABLE entry × ping-pong × freeze × test
+    // tone × settled, so per-block constants never reach the inner loops:
+    // unused heads are never read, modes without reverb never touch the
+    // springs, and settled sub-blocks use constant parameters (no ramps).
+    template <int ModeIndex, bool PingPong, bool Frozen, bool TestTone, bool Settled>
+    void processSubBlock (float* left, float* right, int numSamples, BlockContext& ctx);
+
+    using SubBlockKernel = void (SpaceEchoAudioProcessor::*) (float*, float*, int, BlockContext&);
+
+    template <size_t... Index>
+    static constexpr std::array<SubBlockKernel, sizeof... (Index)> makeKernelTable (std::index_sequence<Index...>) noexcept;
+
+    static SubBlockKernel getKernel (int modeIndex, bool pingpong, bool frozen,
+                                     bool testTone, bool settled) noexcept;
+
+    int lastModeIndex = 0; // mode of the previous block (EQ state hand-over)
+
+    // ── Sleep mode / tail ─────────────────────────────────────────────
+    // While input is silent and every recirculating loop has rung out the
+    // whole chain is skipped and the block is cleared.
+    bool sleeping = false;
+    std::atomic<double> tailSeconds { 3.0 }; // from the current loop settings
 
     /** Soft clipper: tanh-based, transparent below ~0 dBFS, hard limit above. */
     static float softClip (float x) noexcept
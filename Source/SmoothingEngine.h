@@ -0,0 +1,144 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+
+/**
+ *  Per-sample value of a parameter that is not moving — stands in for a
+ *  ramp buffer wherever DSP code indexes a per-sample parameter array.
+ */
+struct ConstantParam
+{
+    float value;
+    float operator[] (int) const noexcept { return value; }
+};
+
+/**
+ *  SmoothingEngine — NumParams linear parameter ramps advanced together.
+ *
+ *  Same semantics as juce::SmoothedValue<float, Linear> (a new target restarts
+ *  a fixed-length ramp from the current value), but state is stored per field
+ *  so that:
+ *   • isSettled() is one check for all parameters — callers switch to
+ *     constant-parameter kernels (ConstantParam) while nothing moves
+ *   • fillRamps() writes every ramp as  current + step × (i + 1), with no
+ *     loop-carried dependency, so each ramp is a single vectorisable pass
+ */
+template <int NumParams>
+class SmoothingEngine
+{
+public:
+    static constexpr int NUM_PARAMS = NumParams;
+
+    void reset (double sampleRate, double rampLengthSeconds) noexcept
+    {
+        stepsToTarget = static_cast<int> (std::floor (rampLengthSeconds * sampleRate));
+        for (int k = 0; k < NumParams; ++k)
+            setCurrentAndTargetValue (k, target[(size_t) k]);
+    }
+
+    void setCurrentAndTargetValue (int k, float value) noexcept
+    {
+        current  [(size_t) k] = value;
+        target   [(size_t) k] = value;
+        step     [(size_t) k] = 0.f;
+        countdown[(size_t) k] = 0;
+    }
+
+    void setTargetValue (int k, float value) noexcept
+    {
+        if (value == target[(size_t) k])
+            return;
+
+        if (stepsToTarget <= 0)
+        {
+            setCurrentAndTargetValue (k, value);
+            return;
+        }
+
+        target   [(size_t) k] = value;
+        countdown[(size_t) k] = stepsToTarget;
+        step     [(size_t) k] = (value - current[(size_t) k]) / static_cast<float> (stepsToTarget);
+    }
+
+    float getCurrentValue (int k) const noexcept { return current[(size_t) k]; }
+    float getTargetValue  (int k) const noexcept { return target [(size_t) k]; }
+
+    bool isSmoothing (int k) const noexcept { return countdown[(size_t) k] > 0; }
+
+    /** True when no parameter is ramping: every value equals its target. */
+    bool isSettled() const noexcept
+    {
+        for (const auto c : countdown)
+            if (c > 0) return false;
+        return true;
+    }
+
+    /** Advance every ramp by numSamples without rendering it. */
+    void skip (int numSamples) noexcept
+    {
+        for (int k = 0; k < NumParams; ++k)
+        {
+            const int cd = countdown[(size_t) k];
+            if (cd == 0)
+                continue;
+
+            if (numSamples >= cd)
+            {
+                setCurrentAndTargetValue (k, target[(size_t) k]);
+            }
+            else
+            {
+                current  [(size_t) k] += step[(size_t) k] * static_cast<float> (numSamples);
+                countdown[(size_t) k] = cd - numSamples;
+            }
+        }
+    }
+
+    /**
+     *  Render the next numSamples values of every parameter and advance.
+     *  @param ramps  NumParams destination buffers, indexed like the parameters
+     */
+    template <typename Buffers>
+    void fillRamps (Buffers& ramps, int numSamples) noexcept
+    {
+        for (int k = 0; k < NumParams; ++k)
+        {
+            float* dest = ramps[(size_t) k].data();
+            const float tgt = target[(size_t) k];
+            const int   cd  = countdown[(size_t) k];
+
+            if (cd == 0)
+            {
+                std::fill_n (dest, numSamples, tgt);
+                continue;
+            }
+
+            // Ramp part (the final ramp sample lands exactly on the target)
+            const float cur = current[(size_t) k];
+            const float stp = step[(size_t) k];
+            const int   len = juce::jmin (cd, numSamples);
+
+            for (int i = 0; i < len; ++i)
+                dest[i] = cur + stp * static_cast<float> (i + 1);
+
+            if (len == cd)
+            {
+                dest[len - 1] = tgt;
+                std::fill (dest + len, dest + numSamples, tgt);
+                setCurrentAndTargetValue (k, tgt);
+            }
+            else
+            {
+                current  [(size_t) k] = dest[len - 1];
+                countdown[(size_t) k] = cd - len;
+            }
+        }
+    }
+
+private:
+    std::array<float, NumParams> current   {};
+    std::array<float, NumParams> target    {};
+    std::array<float, NumParams> step      {};
+    std::array<int,   NumParams> countdown {};
+    int stepsToTarget = 0;
+};
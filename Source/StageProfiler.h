@@ -0,0 +1,274 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#ifndef SPACEECHO_PROFILING
+ #define SPACEECHO_PROFILING 0
+#endif
+
+/**
+ *  StageProfiler — per-stage timing of processBlock on the audio thread.
+ *
+ *  Stage timers add their scope's duration to the current block; at the end
+ *  of the block each stage that ran folds its block total into lock-free
+ *  statistics that the editor (or a file dump) reads at any time:
+ *
+ *   • count, min, mean, max, p50 / p95 / p99 (¼-octave log histogram)
+ *   • load — stage time as a fraction of the block's realtime budget
+ *
+ *  Single writer (the audio thread): relaxed loads and stores on the
+ *  statistics, no locks.  The only read-modify-write is the audio thread
+ *  taking the reader's reset request (one exchange per block).  A reader
+ *  may see a block half-applied, which is fine for diagnostics.  Timing
+ *  uses std::chrono::steady_clock (portable across x86 and ARM, no TSC
+ *  calibration needed).
+ *
+ *  The SPACEECHO_PROFILE_* macros compile to nothing unless the build sets
+ *  SPACEECHO_PROFILING (CMake option of the same name).
+ */
+class StageProfiler
+{
+public:
+    enum Stage : int { noise, tape, eq, reverb, shimmer, output, total, NUM_STAGES };
+
+    static constexpr const char* STAGE_NAMES[NUM_STAGES] =
+        { "noise", "tape", "eq", "reverb", "shimmer", "output", "total" };
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Stats
+    {
+        std::uint64_t count = 0;                          // blocks the stage ran in
+        double minUs = 0.0, meanUs = 0.0, maxUs = 0.0;    // per block
+        double p50Us = 0.0, p95Us = 0.0, p99Us = 0.0;
+        double meanLoad = 0.0, peakLoad = 0.0;            // fraction of block duration
+    };
+
+    // ── Audio thread ──────────────────────────────────────────────────
+    /** Adds the lifetime of the scope to one stage of the current block. */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer (StageProfiler& p, Stage s) noexcept
+            : profiler (p), stage (s), start (Clock::now()) {}
+
+        ~ScopedTimer() noexcept { profiler.addTime (stage, Clock::now() - start); }
+
+    private:
+        StageProfiler&    profiler;
+        Stage             stage;
+        Clock::time_point start;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedTimer)
+    };
+
+    /** Times a whole processBlock as Stage::total, then closes the block. */
+    class BlockTimer
+    {
+    public:
+        BlockTimer (StageProfiler& p, int numSamples, double sampleRate) noexcept
+            : profiler (p), start (Clock::now()),
+              budgetNs (static_cast<double> (numSamples) * 1.0e9 / sampleRate) {}
+
+        ~BlockTimer() noexcept
+        {
+            profiler.addTime (total, Clock::now() - start);
+            profiler.endBlock (budgetNs);
+        }
+
+    private:
+        StageProfiler&    profiler;
+        Clock::time_point start;
+        double            budgetNs;
+
+        JUCE_DECLARE_NON_COPYABLE (BlockTimer)
+    };
+
+    // ── Any thread ────────────────────────────────────────────────────
+    /** Clears the statistics; applied by the audio thread at its next block. */
+    void requestReset() noexcept { resetRequested.store (true, std::memory_order_relaxed); }
+
+    Stats getStats (Stage s) const noexcept
+    {
+        const auto& a = accumulators[(size_t) s];
+        Stats st;
+
+        st.count = a.count.load (std::memory_order_relaxed);
+        if (st.count == 0)
+            return st;
+
+        const auto sumNs    = a.sumNs   .load (std::memory_order_relaxed);
+        const auto budgetNs = a.budgetNs.load (std::memory_order_relaxed);
+
+        st.minUs    = a.minNs.load (std::memory_order_relaxed) * 1.0e-3;
+        st.maxUs    = a.maxNs.load (std::memory_order_relaxed) * 1.0e-3;
+        st.meanUs   = static_cast<double> (sumNs) / static_cast<double> (st.count) * 1.0e-3;
+        st.meanLoad = budgetNs > 0 ? static_cast<double> (sumNs) / static_cast<double> (budgetNs) : 0.0;
+        st.peakLoad = a.peakLoad.load (std::memory_order_relaxed);
+
+        // Percentiles: upper edge of the bucket holding the rank, capped at max
+        std::array<std::uint32_t, NUM_BUCKETS> hist;
+        std::uint64_t histTotal = 0;
+        for (size_t b = 0; b < NUM_BUCKETS; ++b)
+            histTotal += (hist[b] = a.histogram[b].load (std::memory_order_relaxed));
+
+        auto percentile = [&] (double q)
+        {
+            const auto rank = static_cast<std::uint64_t> (q * static_cast<double> (histTotal));
+            std::uint64_t seen = 0;
+            for (size_t b = 0; b < NUM_BUCKETS; ++b)
+            {
+                seen += hist[b];
+                if (seen > rank)
+                    return juce::jmin (st.maxUs, static_cast<double> (bucketUpperNs ((int) b)) * 1.0e-3);
+            }
+            return st.maxUs;
+        };
+
+        st.p50Us = percentile (0.50);
+        st.p95Us = percentile (0.95);
+        st.p99Us = percentile (0.99);
+        return st;
+    }
+
+    /** Plain-text table of every stage (overlay "dump", bug reports). */
+    juce::String toText() const
+    {
+        juce::String text;
+        text << "stage      blocks      min us     mean us      p50 us      p95 us      p99 us      max us   load %   peak %\n";
+
+        for (int s = 0; s < NUM_STAGES; ++s)
+        {
+            const auto st = getStats (static_cast<Stage> (s));
+            auto col = [] (double v, int decimals) { return juce::String (v, decimals).paddedLeft (' ', 12); };
+
+            text << juce::String (STAGE_NAMES[s]).paddedRight (' ', 8)
+                 << juce::String ((juce::int64) st.count).paddedLeft (' ', 9)
+                 << col (st.minUs, 2)  << col (st.meanUs, 2)
+                 << col (st.p50Us, 2)  << col (st.p95Us, 2) << col (st.p99Us, 2)
+                 << col (st.maxUs, 2)
+                 << juce::String (st.meanLoad * 100.0, 2).paddedLeft (' ', 9)
+                 << juce::String (st.peakLoad * 100.0, 1).paddedLeft (' ', 9) << "\n";
+        }
+
+        return text;
+    }
+
+    bool dumpToFile (const juce::File& file) const
+    {
+        return file.replaceWithText (juce::Time::getCurrentTime().toString (true, true) + "\n\n" + toText());
+    }
+
+private:
+    // ¼-octave buckets: 4 per power of two, covering 0 ns … 2^32 ns
+    static constexpr int NUM_BUCKETS = 128;
+
+    struct Accumulator
+    {
+        std::atomic<std::uint64_t> count    { 0 };
+        std::atomic<std::uint64_t> sumNs    { 0 };
+        std::atomic<std::uint64_t> budgetNs { 0 };
+        std::atomic<std::uint32_t> minNs    { 0 };
+        std::atomic<std::uint32_t> maxNs    { 0 };
+        std::atomic<float>         peakLoad { 0.f };
+        std::array<std::atomic<std::uint32_t>, NUM_BUCKETS> histogram {};
+    };
+
+    std::array<Accumulator, NUM_STAGES> accumulators;
+    std::atomic<bool> resetRequested { false };
+
+    // Audio-thread only: this block's time per stage, and which stages ran
+    std::array<Clock::duration, NUM_STAGES> pending {};
+    unsigned ranMask = 0;
+
+    static int bucketIndex (std::uint32_t ns) noexcept
+    {
+        if (ns < 8)
+            return static_cast<int> (ns);
+
+        const int msb = juce::findHighestSetBit (ns);
+        return msb * 4 + static_cast<int> ((ns >> (msb - 2)) & 3u);
+    }
+
+    static std::uint64_t bucketUpperNs (int b) noexcept
+    {
+        if (b < 8)
+            return static_cast<std::uint64_t> (b + 1);
+
+        return static_cast<std::uint64_t> (5 + (b & 3)) << ((b >> 2) - 2);
+    }
+
+    void addTime (Stage s, Clock::duration d) noexcept
+    {
+        pending[(size_t) s] += d;
+        ranMask |= 1u << s;
+    }
+
+    template <typename T>
+    static void bump (std::atomic<T>& a, T delta) noexcept
+    {
+        a.store (a.load (std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+
+    void endBlock (double budgetNs) noexcept
+    {
+        if (resetRequested.exchange (false, std::memory_order_relaxed))
+            clearAccumulators();
+
+        for (int s = 0; s < NUM_STAGES; ++s)
+        {
+            if (! (ranMask >> s & 1u))
+                continue;
+
+            const auto ns64 = std::chrono::duration_cast<std::chrono::nanoseconds> (pending[(size_t) s]).count();
+            const auto ns   = static_cast<std::uint32_t> (juce::jlimit<long long> (0, 0xFFFFFFFFll, ns64));
+            auto& a = accumulators[(size_t) s];
+
+            const bool first = a.count.load (std::memory_order_relaxed) == 0;
+            if (first || ns < a.minNs.load (std::memory_order_relaxed)) a.minNs.store (ns, std::memory_order_relaxed);
+            if (first || ns > a.maxNs.load (std::memory_order_relaxed)) a.maxNs.store (ns, std::memory_order_relaxed);
+
+            const auto load = static_cast<float> (ns / budgetNs);
+            if (load > a.peakLoad.load (std::memory_order_relaxed))
+                a.peakLoad.store (load, std::memory_order_relaxed);
+
+            bump<std::uint64_t> (a.sumNs,    ns);
+            bump<std::uint64_t> (a.budgetNs, static_cast<std::uint64_t> (budgetNs));
+            bump<std::uint32_t> (a.histogram[(size_t) bucketIndex (ns)], 1u);
+            bump<std::uint64_t> (a.count,    1u); // last: readers key off count
+
+            pending[(size_t) s] = {};
+        }
+
+        ranMask = 0;
+    }
+
+    void clearAccumulators() noexcept
+    {
+        for (auto& a : accumulators)
+        {
+            a.count   .store (0, std::memory_order_relaxed);
+            a.sumNs   .store (0, std::memory_order_relaxed);
+            a.budgetNs.store (0, std::memory_order_relaxed);
+            a.minNs   .store (0, std::memory_order_relaxed);
+            a.maxNs   .store (0, std::memory_order_relaxed);
+            a.peakLoad.store (0.f, std::memory_order_relaxed);
+            for (auto& h : a.histogram)
+                h.store (0, std::memory_order_relaxed);
+        }
+    }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+#if SPACEECHO_PROFILING
+ #define SPACEECHO_PROFILE_STAGE(profiler, stage) \
+    const StageProfiler::ScopedTimer JUCE_JOIN_MACRO (stageTimer_, __LINE__) { profiler, StageProfiler::stage }
+ #define SPACEECHO_PROFILE_BLOCK(profiler, numSamples, sampleRate) \
+    const StageProfiler::BlockTimer JUCE_JOIN_MACRO (blockTimer_, __LINE__) { profiler, numSamples, sampleRate }
+#else
+ #define SPACEECHO_PROFILE_STAGE(profiler, stage)
+ #define SPACEECHO_PROFILE_BLOCK(profiler, numSamples, sampleRate)
+#endif
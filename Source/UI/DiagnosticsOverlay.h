@@ -0,0 +1,142 @@
+#pragma once
+#include <JuceHeader.h>
+#include "IndustrialLookAndFeel.h"
+#include "../StageProfiler.h"
+#include <array>
+#include <initializer_list>
+
+/**
+ *  DiagnosticsOverlay — hidden per-stage CPU table over the editor.
+ *
+ *  Shows the StageProfiler statistics of the audio thread: time per block
+ *  (min / mean / p50 / p95 / p99 / max, µs) and load as a share of the
+ *  block's realtime budget.  RESET clears the statistics, DUMP writes the
+ *  table to a text file on the desktop.
+ *
+ *  Toggled by double-clicking the SPACE ECHO logo; refreshed by the editor
+ *  timer only while visible.
+ */
+class DiagnosticsOverlay : public juce::Component
+{
+public:
+    explicit DiagnosticsOverlay (StageProfiler& p) : profiler (p)
+    {
+        for (auto* b : { &resetBtn, &dumpBtn })
+        {
+            b->setColour (juce::TextButton::buttonColourId, juce::Colour (0xFF2A2A2A));
+            b->setColour (juce::TextButton::textColourOffId, juce::Colour (IndustrialLookAndFeel::COL_AMBER));
+            addAndMakeVisible (*b);
+        }
+
+        resetBtn.onClick = [this]
+        {
+            profiler.requestReset();
+            status = "statistics cleared";
+        };
+
+        dumpBtn.onClick = [this]
+        {
+            const auto file = juce::File::getSpecialLocation (juce::File::userDesktopDirectory)
+                                  .getChildFile ("SpaceEcho-profile-"
+                                                 + juce::Time::getCurrentTime().formatted ("%Y%m%d-%H%M%S")
+                                                 + ".txt");
+            status = profiler.dumpToFile (file) ? "written to " + file.getFullPathName()
+                                                : "cannot write " + file.getFullPathName();
+            repaint();
+        };
+    }
+
+    /** Called from the editor timer while visible. */
+    void refresh()
+    {
+        for (int s = 0; s < StageProfiler::NUM_STAGES; ++s)
+            stats[(size_t) s] = profiler.getStats (static_cast<StageProfiler::Stage> (s));
+        repaint();
+    }
+
+    // ─────────────────────────────────────────────────────────────────
+    void paint (juce::Graphics& g) override
+    {
+        const auto area = getLocalBounds().toFloat();
+
+        g.setColour (juce::Colour (0xE8080808));
+        g.fillRoundedRectangle (area, 6.f);
+        g.setColour (juce::Colour (IndustrialLookAndFeel::COL_AMBER).withAlpha (0.5f));
+        g.drawRoundedRectangle (area.reduced (0.5f), 6.f, 1.f);
+
+        g.setFont (IndustrialLookAndFeel::getIndustrialFont (10.f));
+        g.setColour (juce::Colour (IndustrialLookAndFeel::COL_LABEL));
+        g.drawText ("AUDIO THREAD - TIME PER BLOCK (us)", 14, 8, getWidth() - 28, 18,
+                    juce::Justification::centredLeft);
+
+        if (! SPACEECHO_PROFILING)
+        {
+            g.setColour (juce::Colour (IndustrialLookAndFeel::COL_LABEL_DIM));
+            g.drawText ("Profiling is disabled in this build (SPACEECHO_PROFILING=OFF)",
+                        getLocalBounds().reduced (14, 40), juce::Justification::centred);
+            return;
+        }
+
+        // ── Table ─────────────────────────────────────────────────────
+        constexpr int numCols = 10;
+        const int     rowH    = 18;
+        const float   colW    = static_cast<float> (getWidth() - 28) / static_cast<float> (numCols);
+
+        auto drawRow = [&] (int row, std::initializer_list<juce::String> cells, juce::Colour colour)
+        {
+            g.setColour (colour);
+            int c = 0;
+            for (const auto& cell : cells)
+            {
+                g.drawText (cell,
+                            juce::Rectangle<float> (14.f + colW * static_cast<float> (c),
+                                                    static_cast<float> (32 + row * rowH), colW, (float) rowH),
+                            c == 0 ? juce::Justification::centredLeft : juce::Justification::centredRight);
+                ++c;
+            }
+        };
+
+        drawRow (0, { "STAGE", "BLOCKS", "MIN", "MEAN", "P50", "P95", "P99", "MAX", "LOAD %", "PEAK %" },
+                 juce::Colour (IndustrialLookAndFeel::COL_LABEL_DIM));
+
+        for (int s = 0; s < StageProfiler::NUM_STAGES; ++s)
+        {
+            const auto& st = stats[(size_t) s];
+            const auto  us = [] (double v) { return juce::String (v, 1); };
+
+            // A block over its budget is an overload: flag the peak in red
+            const auto colour = st.peakLoad >= 1.0 ? juce::Colour (IndustrialLookAndFeel::COL_RED)
+                              : s == StageProfiler::total ? juce::Colour (IndustrialLookAndFeel::COL_WHITE)
+                                                          : juce::Colour (IndustrialLookAndFeel::COL_AMBER);
+
+            drawRow (s + 1, { juce::String (StageProfiler::STAGE_NAMES[s]).toUpperCase(),
+                              juce::String ((juce::int64) st.count),
+                              us (st.minUs), us (st.meanUs), us (st.p50Us),
+                              us (st.p95Us), us (st.p99Us), us (st.maxUs),
+                              juce::String (st.meanLoad * 100.0, 1),
+                              juce::String (st.peakLoad * 100.0, 1) },
+                     colour);
+        }
+
+        if (status.isNotEmpty())
+        {
+            g.setColour (juce::Colour (IndustrialLookAndFeel::COL_LABEL_DIM));
+            g.drawText (status, 14, getHeight() - 30, getWidth() - 200, 20,
+                        juce::Justification::centredLeft);
+        }
+    }
+
+    void resized() override
+    {
+        dumpBtn .setBounds (getWidth() - 84,  getHeight() - 32, 70, 24);
+        resetBtn.setBounds (getWidth() - 162, getHeight() - 32, 70, 24);
+    }
+
+private:
+    StageProfiler& profiler;
+    std::array<StageProfiler::Stats, StageProfiler::NUM_STAGES> stats {};
+
+    juce::TextButton resetBtn { "RESET" };
+    juce::TextButton dumpBtn  { "DUMP"  };
+    juce::String     status;
+};
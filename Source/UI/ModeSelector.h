@@ -5,16 +5,17 @@
 /**
  *  ModeSelector — RE-201 style large rotary selector dial.
  *
- *  12 positions arranged on a 300° arc (gap at the bottom).
+ *  13 positions arranged on a 300° arc (gap at the bottom).
  *  Click or drag anywhere on/around the dial to select a position.
  *
  *  Positions 1-7  → echo only  (white/amber ticks)
  *  Positions 8-12 → reverb     (red ticks)
+ *  Position  13   → multi-tap  (blue tick)
  */
 class ModeSelector : public juce::Component
 {
 public:
-    static constexpr int NUM_MODES = 12;
+    static constexpr int NUM_MODES = 13;
 
     std::function<void (int)> onModeChanged;
 
@@ -112,13 +113,16 @@ public:
             const float ang  = arcStart + t * arcRange;
             const float sinA = std::sin (ang), cosA = std::cos (ang);
 
-            const bool isReverb   = (i >= 7);
+            const bool isTaps     = (i == NUM_MODES - 1);
+            const bool isReverb   = (i >= 7 && ! isTaps);
             const bool isSelected = (i == currentMode);
 
             // Tick mark
             const float r1 = notchInner;
             const float r2 = notchOuter + (isSelected ? 4.f : 0.f);
-            juce::Colour tickCol = isReverb
+            juce::Colour tickCol = isTaps
+                ? (isSelected ? juce::Colour (0xFF66BBFF) : juce::Colour (0xFF335577))
+                : isReverb
                 ? (isSelected ? juce::Colour (0xFFFF5533) : juce::Colour (0xFF773322))
                 : (isSelected ? juce::Colour (0xFFFFCC00) : juce::Colour (0xFF777777));
             g.setColour (tickCol);
@@ -129,7 +133,9 @@ public:
             // Mode number
             g.setFont (juce::Font (juce::FontOptions ("Arial", fontSize,
                                    isSelected ? juce::Font::bold : juce::Font::plain)));
-            g.setColour (isReverb
+            g.setColour (isTaps
+                ? (isSelected ? juce::Colour (0xFF66BBFF) : juce::Colour (0xFF335566))
+                : isReverb
                 ? (isSelected ? juce::Colour (0xFFFF6644) : juce::Colour (0xFF663322))
                 : (isSelected ? juce::Colour (0xFFFFCC00) : juce::Colour (0xFF666666)));
             const float lx = cx + cosA * labelR;
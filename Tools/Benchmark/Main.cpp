@@ -0,0 +1,550 @@
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <type_traits>
+
+/**
+ *  spaceecho-benchmark — ns/sample of every DSP class and of the full
+ *  SpaceEchoAudioProcessor::processBlock.
+ *
+ *    spaceecho-benchmark [options]
+ *
+ *      --json <file>     also write the results as JSON (for regression tracking)
+ *      --label <text>    free-form tag stored in the JSON (release, commit, …)
+ *      --filter <text>   only run benchmarks whose name contains text
+ *      --seconds <s>     audio rendered per timed run (default 0.5)
+ *      --runs <n>        timed runs per case, min and median reported (default 5)
+ *      --quick           44.1/96 kHz and 64/512-sample blocks only
+ *
+ *  Cases: every DSP class at each sample rate × block size (the tape once per
+ *  head interpolator), and processBlock at each sample rate × block size ×
+ *  mode.  Inputs are continuous noise so nothing ever goes to sleep.  Stereo
+ *  cases count one sample per frame.
+ *
+ *  A final "noise floor" table gives the error of each tape head interpolator
+ *  reading a sine through a modulated delay, in dB below the signal.
+ */
+namespace
+{
+    constexpr double SAMPLE_RATES[] = { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+    constexpr int    BLOCK_SIZES[]  = { 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+    constexpr int    MAX_BLOCK      = 4096;
+
+    struct Options
+    {
+        juce::File   jsonFile;
+        juce::String label;
+        juce::String filter;
+        double       seconds = 0.5;
+        int          runs    = 5;
+        bool         quick   = false;
+    };
+
+    struct Result
+    {
+        juce::String name;
+        double       sampleRate;
+        int          blockSize;
+        int          mode;          // −1 for the DSP classes
+        double       nsMin, nsMedian;
+    };
+
+    struct NoiseFloor
+    {
+        juce::String interpolator;
+        double       frequency;
+        double       db;
+    };
+
+    /** Renders numSamples starting at offset into the case's own buffers. */
+    using ChunkFn = std::function<void (int offset, int numSamples)>;
+
+    // ─────────────────────────────────────────────────────────────────────
+    bool parseArgs (const juce::ArgumentList& args, Options& opts)
+    {
+        for (int i = 0; i < args.size(); ++i)
+        {
+            const auto arg = args[i].text;
+            auto next = [&]() -> juce::String
+            {
+                return (i + 1 < args.size()) ? args[++i].text : juce::String();
+            };
+
+            if      (arg == "--json")    opts.jsonFile = juce::File::getCurrentWorkingDirectory().getChildFile (next());
+            else if (arg == "--label")   opts.label    = next();
+            else if (arg == "--filter")  opts.filter   = next();
+            else if (arg == "--seconds") opts.seconds  = next().getDoubleValue();
+            else if (arg == "--runs")    opts.runs     = next().getIntValue();
+            else if (arg == "--quick")   opts.quick    = true;
+            else
+            {
+                std::cerr << "Unknown option " << arg << "\n";
+                return false;
+            }
+        }
+
+        opts.seconds = juce::jlimit (0.01, 60.0, opts.seconds);
+        opts.runs    = juce::jmax (1, opts.runs);
+        return true;
+    }
+
+    /** Deterministic full-band noise, −12 dBFS peak. */
+    std::vector<float> makeNoise (int numSamples, juce::int64 seed)
+    {
+        juce::Random rng (seed);
+        std::vector<float> v ((size_t) numSamples);
+        for (auto& x : v)
+            x = (rng.nextFloat() * 2.f - 1.f) * 0.25f;
+        return v;
+    }
+
+    // ─────────────────────────────────────────────────────────────────────
+    /**
+     *  One warm-up pass, then opts.runs timed passes over opts.seconds of
+     *  audio, each split into blockSize chunks.  Returns { min, median } ns/sample.
+     */
+    std::pair<double, double> measure (const Options& opts, double sampleRate,
+                                       int blockSize, const ChunkFn& processChunk)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        const int total = juce::jmax (blockSize, static_cast<int> (opts.seconds * sampleRate));
+
+        auto pass = [&]
+        {
+            for (int pos = 0; pos < total; pos += blockSize)
+                processChunk (pos % MAX_BLOCK, juce::jmin (blockSize, total - pos, MAX_BLOCK - pos % MAX_BLOCK));
+        };
+
+        pass();
+
+        std::vector<double> ns;
+        for (int r = 0; r < opts.runs; ++r)
+        {
+            const auto t0 = Clock::now();
+            pass();
+            const auto t1 = Clock::now();
+            ns.push_back (std::chrono::duration<double, std::nano> (t1 - t0).count() / total);
+        }
+
+        std::sort (ns.begin(), ns.end());
+        return { ns.front(), ns[ns.size() / 2] };
+    }
+
+    // ── DSP classes ──────────────────────────────────────────────────────
+    // Each case feeds the class through the same block API the processor uses.
+    /** numTaps > 0: the multi-tap bank (readTaps) instead of the three heads. */
+    ChunkFn makeTapeDelayCase (double sampleRate, int interpolation, bool compact = false, int numTaps = 0)
+    {
+        using Tape = StereoTapeDelay;
+
+        struct State
+        {
+            Tape tape;
+            std::array<std::array<std::vector<float>, Tape::NUM_HEADS>, 2> heads;
+            std::array<std::vector<float>, 2> tapeIn;
+            Tape::HeadBuffers headPtrs {};
+            std::vector<float> noise = makeNoise (MAX_BLOCK, 1);
+            ConstantParam delay { 0.f }, wowFlutter { 0.3f }, saturation { 0.3f };
+        };
+
+        auto s = std::make_shared<State>();
+        s->tape.prepare (sampleRate, 750.f, { 0.0f, 0.37f }, MAX_BLOCK, compact);
+        s->tape.setInterpolation (interpolation);
+        s->delay.value = static_cast<float> (0.3 * sampleRate); // 300 ms: 4096-sample blocks stay legal
+
+        if (numTaps > 0)
+        {
+            // Evenly spread from head 1 to head 3, alternating sides
+            Tape::TapPattern pattern;
+            pattern.numTaps = numTaps;
+            for (int k = 0; k < numTaps; ++k)
+            {
+                pattern.ratio[(size_t) k] = 1.f + (Tape::MAX_TAP_RATIO - 1.f) * (float) k / (float) numTaps;
+                pattern.level[(size_t) k] = 1.f;
+                pattern.pan  [(size_t) k] = (k & 1) != 0 ? 0.5f : -0.5f;
+            }
+            s->tape.setTapPattern (pattern);
+        }
+
+        for (int c = 0; c < 2; ++c)
+        {
+            s->tapeIn[(size_t) c].assign (MAX_BLOCK, 0.f);
+            for (int h = 0; h < Tape::NUM_HEADS; ++h)
+            {
+                s->heads[(size_t) c][(size_t) h].assign (MAX_BLOCK, 0.f);
+                s->headPtrs[(size_t) c][(size_t) h] = s->heads[(size_t) c][(size_t) h].data();
+            }
+        }
+
+        jassert (s->tape.getMaxBlockLength (s->delay.value) >= MAX_BLOCK);
+
+        return [s, numTaps] (int offset, int n)
+        {
+            if (numTaps > 0)
+            {
+                float* taps[] = { s->headPtrs[0][0], s->headPtrs[1][0] };
+                s->tape.readTaps (taps, s->delay, s->wowFlutter, n);
+            }
+            else
+            {
+                s->tape.readBlock (s->headPtrs, s->delay, s->wowFlutter, n);
+            }
+
+            for (int c = 0; c < 2; ++c)
+                for (int i = 0; i < n; ++i)
+                    s->tapeIn[(size_t) c][(size_t) i] = s->noise[(size_t) (offset + i)]
+                                                      + 0.5f * s->heads[(size_t) c][0][(size_t) i];
+
+            const float* in[2] = { s->tapeIn[0].data(), s->tapeIn[1].data() };
+            s->tape.writeBlock (in, s->saturation, n);
+        };
+    }
+
+    /** Mono in-place block processor: io is refilled with noise every chunk.
+        setup runs once after prepare(). */
+    template <typename Dsp, typename Process>
+    ChunkFn makeInPlaceCase (double sampleRate, Process&& process,
+                             const std::function<void (Dsp&)>& setup = {})
+    {
+        struct State
+        {
+            Dsp dsp;
+            std::vector<float> io    = std::vector<float> (MAX_BLOCK);
+            std::vector<float> noise = makeNoise (MAX_BLOCK, 2);
+        };
+
+        auto s = std::make_shared<State>();
+        if constexpr (std::is_invocable_v<decltype (&Dsp::prepare), Dsp&, double, int>)
+            s->dsp.prepare (sampleRate, MAX_BLOCK);
+        else
+            s->dsp.prepare (sampleRate);
+        if (setup)
+            setup (s->dsp);
+
+        return [s, process] (int offset, int n)
+        {
+            std::copy_n (s->noise.data() + offset, n, s->io.data());
+            process (s->dsp, s->io.data(), n);
+        };
+    }
+
+    // ── Interpolation noise floor ────────────────────────────────────────
+    /**
+     *  A sine read through a delay swept 100 ± 20 samples at 3 Hz (every
+     *  fraction, tape-like pitch modulation), compared with the exact delayed
+     *  sine.  Returns the error power relative to the signal, in dB.
+     */
+    template <typename Interp>
+    double measureNoiseFloor (double frequency, double sampleRate)
+    {
+        constexpr int numSamples = 200000;
+        constexpr int settle     = 256;
+
+        DelayLine<float> line;
+        line.setMaximumDelay (settle);
+        typename Interp::Window window;
+
+        const double w = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+        double errorPower = 0.0, signalPower = 0.0;
+
+        for (int n = 0; n < numSamples; ++n)
+        {
+            if (n >= settle)
+            {
+                const auto delay = static_cast<float> (100.0 + 20.0 * std::sin (juce::MathConstants<double>::twoPi
+                                                                                 * 3.0 * n / sampleRate));
+                const auto tap = line.template tap<Interp::WIDTH> (line.getWritePos(), delay);
+                window.load (0, tap.frames, 1, 0, tap.frac);
+
+                alignas (InterpolationDetail::Vec::SIMDRegisterSize) float out[InterpolationDetail::LANES];
+                Interp::template interpolate<1> (window).copyToRawArray (out);
+
+                const double exact = std::sin (w * (n - static_cast<double> (delay)));
+                errorPower  += (out[0] - exact) * (out[0] - exact);
+                signalPower += exact * exact;
+            }
+
+            line.push (static_cast<float> (std::sin (w * n)));
+        }
+
+        return 10.0 * std::log10 (juce::jmax (1.0e-30, errorPower / signalPower));
+    }
+
+    std::vector<NoiseFloor> measureNoiseFloors()
+    {
+        constexpr double sampleRate    = 44100.0;
+        constexpr double frequencies[] = { 100.0, 1000.0, 5000.0, 10000.0, 15000.0 };
+
+        std::vector<NoiseFloor> results;
+
+        std::cout << "\nInterpolation noise floor at 44.1 kHz (dB below signal)\n"
+                  << juce::String ("Hz").paddedLeft (' ', 22);
+        for (const double f : frequencies)
+            std::cout << juce::String (f, 0).paddedLeft (' ', 9);
+        std::cout << "\n";
+
+        auto row = [&] (int quality, auto measureOne)
+        {
+            const juce::String name = ParameterTable::INTERPOLATION_NAMES[quality];
+            std::cout << ("TapeDelay/" + name).paddedRight (' ', 22);
+
+            for (const double f : frequencies)
+            {
+                const double db = measureOne (f);
+                results.push_back ({ name, f, db });
+                std::cout << juce::String (db, 1).paddedLeft (' ', 9);
+            }
+            std::cout << "\n";
+        };
+
+        row (0, [&] (double f) { return measureNoiseFloor<LinearInterpolator>     (f, sampleRate); });
+        row (1, [&] (double f) { return measureNoiseFloor<CatmullRomInterpolator> (f, sampleRate); });
+        row (2, [&] (double f) { return measureNoiseFloor<LagrangeInterpolator>   (f, sampleRate); });
+        row (3, [&] (double f) { return measureNoiseFloor<SincInterpolator>       (f, sampleRate); });
+
+        return results;
+    }
+
+    // ── Full processor ───────────────────────────────────────────────────
+    ChunkFn makeProcessorCase (double sampleRate, int blockSize, int mode, bool reducedLoopRate = false)
+    {
+        struct State
+        {
+            SpaceEchoAudioProcessor processor;
+            juce::AudioBuffer<float> buffer { 2, MAX_BLOCK };
+            juce::MidiBuffer midi;
+            std::vector<float> noiseL = makeNoise (MAX_BLOCK, 3), noiseR = makeNoise (MAX_BLOCK, 4);
+        };
+
+        auto s = std::make_shared<State>();
+
+        // The last mode (TAPS) is the multiTap switch, over the MODE dial
+        const bool taps = mode == SpaceEchoAudioProcessor::TAPS_MODE;
+        auto* modeParam = s->processor.apvts.getParameter (ParameterRegistry::getID (ParameterTable::mode));
+        modeParam->setValueNotifyingHost (modeParam->convertTo0to1 (static_cast<float> (taps ? 0 : mode)));
+        auto* tapsParam = s->processor.apvts.getParameter (ParameterRegistry::getID (ParameterTable::multiTap));
+        tapsParam->setValueNotifyingHost (taps ? 1.f : 0.f);
+
+        s->processor.setReducedLoopRate (reducedLoopRate);
+        s->processor.setNonRealtime (true);
+        s->processor.setPlayConfigDetails (2, 2, sampleRate, blockSize);
+        s->processor.prepareToPlay (sampleRate, blockSize);
+
+        return [s] (int offset, int n)
+        {
+            s->buffer.setSize (2, n, false, false, true);
+            s->buffer.copyFrom (0, 0, s->noiseL.data() + offset, n);
+            s->buffer.copyFrom (1, 0, s->noiseR.data() + offset, n);
+            s->processor.processBlock (s->buffer, s->midi);
+        };
+    }
+
+    // ─────────────────────────────────────────────────────────────────────
+    juce::var toJson (const std::vector<Result>& results, const std::vector<NoiseFloor>& noiseFloors,
+                      const Options& opts)
+    {
+        juce::DynamicObject::Ptr root = new juce::DynamicObject();
+        root->setProperty ("version",   ProjectInfo::versionString);
+        root->setProperty ("label",     opts.label);
+        root->setProperty ("timestamp", juce::Time::getCurrentTime().toISO8601 (true));
+        root->setProperty ("cpu",       juce::SystemStats::getCpuModel());
+        root->setProperty ("os",        juce::SystemStats::getOperatingSystemName());
+        root->setProperty ("seconds",   opts.seconds);
+        root->setProperty ("runs",      opts.runs);
+        root->setProperty ("unit",      "ns/sample");
+
+        juce::Array<juce::var> list;
+        for (const auto& r : results)
+        {
+            juce::DynamicObject::Ptr o = new juce::DynamicObject();
+            o->setProperty ("name",       r.name);
+            o->setProperty ("sampleRate", r.sampleRate);
+            o->setProperty ("blockSize",  r.blockSize);
+            if (r.mode >= 0)
+                o->setProperty ("mode", r.mode + 1);
+            o->setProperty ("min",        r.nsMin);
+            o->setProperty ("median",     r.nsMedian);
+            list.add (juce::var (o.get()));
+        }
+
+        root->setProperty ("results", list);
+
+        juce::Array<juce::var> floors;
+        for (const auto& nf : noiseFloors)
+        {
+            juce::DynamicObject::Ptr o = new juce::DynamicObject();
+            o->setProperty ("interpolator", nf.interpolator);
+            o->setProperty ("frequency",    nf.frequency);
+            o->setProperty ("dB",           nf.db);
+            floors.add (juce::var (o.get()));
+        }
+
+        if (! floors.isEmpty())
+            root->setProperty ("noiseFloor", floors);
+        return juce::var (root.get());
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit; // APVTS needs a message manager
+
+    Options opts;
+    if (! parseArgs (juce::ArgumentList (argc, argv), opts))
+        return 1;
+
+    std::vector<double> rates (std::begin (SAMPLE_RATES), std::end (SAMPLE_RATES));
+    std::vector<int>    blocks (std::begin (BLOCK_SIZES), std::end (BLOCK_SIZES));
+    if (opts.quick)
+    {
+        rates  = { 44100.0, 96000.0 };
+        blocks = { 64, 512 };
+    }
+
+    std::vector<Result> results;
+
+    auto run = [&] (const juce::String& name, double sr, int bs, int mode, auto&& makeCase)
+    {
+        if (opts.filter.isNotEmpty() && ! name.containsIgnoreCase (opts.filter))
+            return;
+
+        const auto [nsMin, nsMedian] = measure (opts, sr, bs, makeCase());
+        results.push_back ({ name, sr, bs, mode, nsMin, nsMedian });
+
+        std::cout << name.paddedRight (' ', 22)
+                  << juce::String (sr / 1000.0, 1).paddedLeft (' ', 6) << " kHz"
+                  << juce::String (bs).paddedLeft (' ', 6)
+                  << (mode >= 0 ? ("  mode " + juce::String (mode + 1).paddedLeft (' ', 2)) : juce::String ("         "))
+                  << juce::String (nsMin, 2).paddedLeft (' ', 10) << " ns/sample (min)"
+                  << juce::String (nsMedian, 2).paddedLeft (' ', 10) << " (median)\n";
+    };
+
+    for (const double sr : rates)
+    {
+        for (const int bs : blocks)
+        {
+            for (int q = 0; q < ParameterTable::NUM_INTERPOLATION; ++q)
+                run ("TapeDelay/" + juce::String (ParameterTable::INTERPOLATION_NAMES[q]), sr, bs, -1,
+                     [&] { return makeTapeDelayCase (sr, q); });
+
+            run ("TapeDelay/int16", sr, bs, -1, [&] { return makeTapeDelayCase (sr, 1, true); });
+
+            for (const int taps : { 3, 8 })
+                run ("TapeDelay/" + juce::String (taps) + " taps", sr, bs, -1,
+                     [&] { return makeTapeDelayCase (sr, 1, false, taps); });
+
+            run ("SpringReverb", sr, bs, -1, [&]
+            {
+                return makeInPlaceCase<SpringReverb> (sr, [] (SpringReverb& d, float* io, int n)
+                                                      { d.processBlock (io, n); });
+            });
+
+            run ("SpringReverb/FDN", sr, bs, -1, [&]
+            {
+                return makeInPlaceCase<SpringReverb> (sr, [] (SpringReverb& d, float* io, int n)
+                                                      {
+                                                          d.setEngine (SpringReverb::FDN);
+                                                          d.processBlock (io, n);
+                                                      });
+            });
+
+            // 2 s decaying noise: head on this thread, tail on the worker
+            run ("SpringReverb/IR", sr, bs, -1, [&]
+            {
+                return makeInPlaceCase<SpringReverb> (sr, [] (SpringReverb& d, float* io, int n)
+                                                      { d.processBlock (io, n); },
+                                                      [] (SpringReverb& d)
+                                                      {
+                                                          auto ir = makeNoise ((int) (2.0 * d.getTankSampleRate()), 3);
+                                                          for (size_t i = 0; i < ir.size(); ++i)
+                                                              ir[i] *= std::exp (-3.0f * (float) i / (float) ir.size());
+
+                                                          d.setImpulseResponse (ir.data(), (int) ir.size());
+                                                          d.setEngine (SpringReverb::CONVOLUTION);
+                                                          d.setWorkerRunning (true);
+                                                      });
+            });
+
+            run ("SpringReverb/chirp", sr, bs, -1, [&]
+            {
+                return makeInPlaceCase<SpringReverb> (sr, [] (SpringReverb& d, float* io, int n)
+                                                      {
+                                                          d.setChirp (true);
+                                                          d.processBlock (io, n);
+                                                      });
+            });
+
+            run ("ShimmerChorus", sr, bs, -1, [&]
+            {
+                return makeInPlaceCase<ShimmerChorus> (sr, [] (ShimmerChorus& d, float* io, int n)
+                                                       { d.processBlock (io, ConstantParam { 0.5f }, n); });
+            });
+
+            // Four voices, eight grains on the one buffer
+            run ("ShimmerChorus/Pad", sr, bs, -1, [&]
+            {
+                return makeInPlaceCase<ShimmerChorus> (sr, [] (ShimmerChorus& d, float* io, int n)
+                                                       { d.processBlock (io, ConstantParam { 0.5f }, n); },
+                                                       [] (ShimmerChorus& d)
+                                                       {
+                                                           using P = ParameterRegistry;
+                                                           constexpr int pad = P::NUM_SHIMMER_VOICINGS - 1;
+                                                           d.setVoices (P::SHIMMER_VOICE_SEMITONES[pad],
+                                                                        P::SHIMMER_VOICE_COUNTS[pad]);
+                                                       });
+            });
+
+            // Four-voice pad: the audio thread's share, then frames included
+            for (const bool offline : { false, true })
+                run (offline ? "SpectralShimmer/Pad inline" : "SpectralShimmer/Pad", sr, bs, -1, [&]
+                {
+                    return makeInPlaceCase<SpectralShimmer> (sr, [] (SpectralShimmer& d, float* io, int n)
+                                                             { d.processBlock (io, ConstantParam { 0.5f }, n); },
+                                                             [offline] (SpectralShimmer& d)
+                                                             {
+                                                                 using P = ParameterRegistry;
+                                                                 constexpr int pad = P::NUM_SHIMMER_VOICINGS - 1;
+                                                                 d.setNonRealtime (offline);
+                                                                 d.setWorkerRunning (! offline);
+                                                                 d.setVoices (P::SHIMMER_VOICE_SEMITONES[pad],
+                                                                              P::SHIMMER_VOICE_COUNTS[pad]);
+                                                             });
+                });
+
+            run ("TapeNoise", sr, bs, -1, [&]
+            {
+                return makeInPlaceCase<TapeNoise> (sr, [] (TapeNoise& d, float* io, int n)
+                                                   { d.processBlock (io, ConstantParam { 0.5f }, n); });
+            });
+
+            for (int mode = 0; mode < SpaceEchoAudioProcessor::NUM_MODES; ++mode)
+                run ("processBlock", sr, bs, mode, [&] { return makeProcessorCase (sr, bs, mode); });
+
+            // The tape loop at 44.1 / 48 kHz: only pays off at 88.2 kHz and up
+            if (sr >= 88200.0)
+                for (int mode = 0; mode < SpaceEchoAudioProcessor::NUM_MODES; ++mode)
+                    run ("processBlock/reduced", sr, bs, mode, [&] { return makeProcessorCase (sr, bs, mode, true); });
+        }
+    }
+
+    std::vector<NoiseFloor> noiseFloors;
+    if (opts.filter.isEmpty() || juce::String ("noise floor").containsIgnoreCase (opts.filter))
+        noiseFloors = measureNoiseFloors();
+
+    if (opts.jsonFile != juce::File())
+    {
+        if (! opts.jsonFile.replaceWithText (juce::JSON::toString (toJson (results, noiseFloors, opts))))
+        {
+            std::cerr << "Cannot write " << opts.jsonFile.getFullPathName() << "\n";
+            return 1;
+        }
+
+        std::cout << results.size() << " results written to " << opts.jsonFile.getFullPathName() << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,294 @@
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+/**
+ *  spaceecho-render — offline batch render through SpaceEchoAudioProcessor.
+ *
+ *  No editor, no audio device: each input file is streamed through its own
+ *  processor instance in large blocks, as fast as the CPU allows, with the
+ *  files spread over a thread pool.
+ *
+ *    spaceecho-render [options] <input files…>
+ *
+ *      --state <file>    plugin state (host-saved binary chunk or XML preset)
+ *      --out <dir>       output directory (default: next to each input)
+ *      --format wav|aiff output format (default: same as the input)
+ *      --block <n>       block size in samples (default 4096)
+ *      --tail <sec>      extra render time after the input ends
+ *                        (default: the processor's tail, capped at 30 s)
+ *      --jobs <n>        files rendered in parallel (default: CPU cores)
+ *      --seed <n>        random seed (default: the state's, else 0)
+ *      --spring-ir <file> spring impulse response for the IR reverb engine
+ *      --compact-tape    store the tape as 16-bit (default: the state's)
+ *      --reduced-loop-rate  run the tape loop at ≥ 44.1 kHz when the file
+ *                        rate is 88.2 kHz or more (default: the state's)
+ *
+ *  Output files are named <input>_spaceecho.<ext>.  Mono inputs are fed to
+ *  both channels; output is always stereo.  Oversampling latency is removed
+ *  so the output lines up with the input.
+ *
+ *  Every file gets a fresh, seeded processor: the same input, state, seed and
+ *  block size always render bit-identical output.
+ */
+namespace
+{
+    constexpr double MAX_AUTO_TAIL_SECONDS = 30.0;
+
+    struct Options
+    {
+        juce::File              stateFile;
+        juce::File              outDir;
+        juce::String            format;          // empty = same as input
+        int                     blockSize  = 4096;
+        double                  tailSeconds = -1.0; // < 0 = from the processor
+        int                     jobs       = juce::SystemStats::getNumCpus();
+        juce::int64             seed       = -1;    // < 0 = from the state
+        juce::File              springIr;           // empty = from the state
+        bool                    compactTape = false; // true = on, else from the state
+        bool                    reducedLoopRate = false; // true = on, else from the state
+        juce::Array<juce::File> inputs;
+    };
+
+    // ─────────────────────────────────────────────────────────────────────
+    void printUsage()
+    {
+        std::cout << "Usage: spaceecho-render [options] <input files...>\n"
+                     "  --state <file>     plugin state (binary chunk or XML preset)\n"
+                     "  --out <dir>        output directory (default: next to each input)\n"
+                     "  --format wav|aiff  output format (default: same as input)\n"
+                     "  --block <n>        block size in samples (default 4096)\n"
+                     "  --tail <sec>       extra render time after the input ends\n"
+                     "  --jobs <n>         files rendered in parallel (default: CPU cores)\n"
+                     "  --seed <n>         random seed (default: the state's, else 0)\n"
+                     "  --spring-ir <file> spring impulse response (IR reverb engine)\n"
+                     "  --compact-tape     store the tape as 16-bit (default: the state's)\n"
+                     "  --reduced-loop-rate  tape loop at >= 44.1 kHz for 88.2 kHz+ files (default: the state's)\n";
+    }
+
+    bool parseArgs (const juce::ArgumentList& args, Options& opts)
+    {
+        for (int i = 0; i < args.size(); ++i)
+        {
+            const auto arg = args[i].text;
+            auto next = [&]() -> juce::String
+            {
+                return (i + 1 < args.size()) ? args[++i].text : juce::String();
+            };
+
+            if      (arg == "--state")  opts.stateFile   = juce::File::getCurrentWorkingDirectory().getChildFile (next());
+            else if (arg == "--out")    opts.outDir      = juce::File::getCurrentWorkingDirectory().getChildFile (next());
+            else if (arg == "--format") opts.format      = next().toLowerCase();
+            else if (arg == "--block")  opts.blockSize   = next().getIntValue();
+            else if (arg == "--tail")   opts.tailSeconds = next().getDoubleValue();
+            else if (arg == "--jobs")   opts.jobs        = next().getIntValue();
+            else if (arg == "--seed")   opts.seed        = next().getLargeIntValue() & 0xFFFFFFFF;
+            else if (arg == "--spring-ir") opts.springIr = juce::File::getCurrentWorkingDirectory().getChildFile (next());
+            else if (arg == "--compact-tape") opts.compactTape = true;
+            else if (arg == "--reduced-loop-rate") opts.reducedLoopRate = true;
+            else if (arg.startsWith ("--"))
+            {
+                std::cerr << "Unknown option " << arg << "\n";
+                return false;
+            }
+            else
+            {
+                opts.inputs.add (juce::File::getCurrentWorkingDirectory().getChildFile (arg));
+            }
+        }
+
+        if (opts.format.isNotEmpty() && opts.format != "wav" && opts.format != "aiff")
+        {
+            std::cerr << "Unsupported format " << opts.format << " (wav or aiff)\n";
+            return false;
+        }
+
+        opts.blockSize = juce::jlimit (16, 65536, opts.blockSize);
+        opts.jobs      = juce::jmax (1, opts.jobs);
+        return ! opts.inputs.isEmpty();
+    }
+
+    // ─────────────────────────────────────────────────────────────────────
+    /** Restores either a host-style binary chunk or a plain XML preset. */
+    bool loadState (SpaceEchoAudioProcessor& processor, const juce::MemoryBlock& state)
+    {
+        if (state.isEmpty())
+            return true;
+
+        // Either way the state goes through setStateInformation(), as in a host
+        juce::MemoryBlock chunk (state);
+        if (auto xml = juce::parseXML (state.toString()))
+        {
+            chunk.reset();
+            juce::AudioProcessor::copyXmlToBinary (*xml, chunk);
+        }
+
+        processor.setStateInformation (chunk.getData(), static_cast<int> (chunk.getSize()));
+
+        const auto xml = juce::AudioProcessor::getXmlFromBinary (chunk.getData(), static_cast<int> (chunk.getSize()));
+        return xml != nullptr && xml->hasTagName (processor.apvts.state.getType());
+    }
+
+    // ─────────────────────────────────────────────────────────────────────
+    /** Renders one file.  Returns an error message, empty on success. */
+    juce::String renderFile (const juce::File& input, const Options& opts,
+                             const juce::MemoryBlock& state)
+    {
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+
+        std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (input));
+        if (reader == nullptr)
+            return "cannot read " + input.getFullPathName();
+
+        // ── Processor, configured like a host would ──────────────────────
+        SpaceEchoAudioProcessor processor;
+        processor.setNonRealtime (true);
+        processor.setPlayConfigDetails (2, 2, reader->sampleRate, opts.blockSize);
+
+        if (! loadState (processor, state))
+            return "state file does not belong to this plugin";
+
+        if (opts.seed >= 0)
+            processor.setRandomSeed (static_cast<uint32_t> (opts.seed));
+
+        if (opts.compactTape)
+            processor.setCompactTapeStorage (true);
+
+        if (opts.reducedLoopRate)
+            processor.setReducedLoopRate (true);
+
+        if (opts.springIr != juce::File() && ! processor.setSpringImpulseResponse (opts.springIr))
+            return "cannot read " + opts.springIr.getFullPathName();
+
+        processor.prepareToPlay (reader->sampleRate, opts.blockSize);
+
+        // ── Output file ───────────────────────────────────────────────────
+        const auto ext = opts.format.isNotEmpty() ? opts.format
+                                                  : input.getFileExtension().substring (1).toLowerCase();
+        const bool aiff = ext == "aiff" || ext == "aif";
+
+        const auto dir    = opts.outDir != juce::File() ? opts.outDir : input.getParentDirectory();
+        const auto output = dir.getChildFile (input.getFileNameWithoutExtension()
+                                              + "_spaceecho" + (aiff ? ".aiff" : ".wav"));
+        output.deleteFile();
+
+        std::unique_ptr<juce::AudioFormat> format;
+        if (aiff) format = std::make_unique<juce::AiffAudioFormat>();
+        else      format = std::make_unique<juce::WavAudioFormat>();
+
+        const int bits = (reader->usesFloatingPointData && ! aiff) ? 32
+                       : juce::jlimit (16, 24, static_cast<int> (reader->bitsPerSample));
+
+        std::unique_ptr<juce::AudioFormatWriter> writer;
+        if (auto stream = output.createOutputStream())
+        {
+            writer.reset (format->createWriterFor (stream.get(), reader->sampleRate, 2,
+                                                   bits, {}, 0));
+            if (writer != nullptr)
+                stream.release(); // owned by the writer now
+        }
+
+        if (writer == nullptr)
+            return "cannot write " + output.getFullPathName();
+
+        // ── Render ────────────────────────────────────────────────────────
+        // prepareToPlay reported the tail for the loaded state, seed and IR
+        double tail = opts.tailSeconds;
+        if (tail < 0.0)
+            tail = juce::jmin (MAX_AUTO_TAIL_SECONDS, processor.getTailLengthSeconds());
+
+        const auto latency     = static_cast<juce::int64> (processor.getLatencySamples());
+        const auto inputLength = reader->lengthInSamples;
+        const auto totalLength = inputLength + static_cast<juce::int64> (tail * reader->sampleRate) + latency;
+
+        juce::AudioBuffer<float> buffer (2, opts.blockSize);
+        juce::MidiBuffer midi;
+
+        for (juce::int64 pos = 0; pos < totalLength; pos += opts.blockSize)
+        {
+            const int n = static_cast<int> (juce::jmin<juce::int64> (opts.blockSize, totalLength - pos));
+            buffer.setSize (2, n, false, false, true);
+            buffer.clear();
+
+            if (pos < inputLength)
+            {
+                const int toRead = static_cast<int> (juce::jmin<juce::int64> (n, inputLength - pos));
+                reader->read (&buffer, 0, toRead, pos, true, true);
+
+                if (reader->numChannels == 1)
+                    buffer.copyFrom (1, 0, buffer, 0, 0, toRead);
+            }
+
+            processor.processBlock (buffer, midi);
+
+            // Drop the first `latency` samples so output lines up with input
+            const auto skip = static_cast<int> (juce::jlimit<juce::int64> (0, n, latency - pos));
+            if (skip < n)
+                writer->writeFromAudioSampleBuffer (buffer, skip, n - skip);
+        }
+
+        processor.releaseResources();
+        return {};
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit; // APVTS needs a message manager
+
+    Options opts;
+    if (! parseArgs (juce::ArgumentList (argc, argv), opts))
+    {
+        printUsage();
+        return 1;
+    }
+
+    juce::MemoryBlock state;
+    if (opts.stateFile != juce::File() && ! opts.stateFile.loadFileAsData (state))
+    {
+        std::cerr << "Cannot read state file " << opts.stateFile.getFullPathName() << "\n";
+        return 1;
+    }
+
+    if (opts.outDir != juce::File())
+        opts.outDir.createDirectory();
+
+    // ── One job per file ─────────────────────────────────────────────────
+    juce::ThreadPool pool (juce::jmin (opts.jobs, opts.inputs.size()));
+    std::atomic<int> failures { 0 };
+    juce::CriticalSection printLock;
+
+    const auto start = juce::Time::getMillisecondCounterHiRes();
+
+    for (const auto& input : opts.inputs)
+    {
+        pool.addJob ([&, input]
+        {
+            const auto t0    = juce::Time::getMillisecondCounterHiRes();
+            const auto error = renderFile (input, opts, state);
+            const auto secs  = (juce::Time::getMillisecondCounterHiRes() - t0) * 0.001;
+
+            const juce::ScopedLock sl (printLock);
+            if (error.isEmpty())
+            {
+                std::cout << input.getFileName() << "  done in "
+                          << juce::String (secs, 2) << " s\n";
+            }
+            else
+            {
+                std::cerr << input.getFileName() << "  FAILED: " << error << "\n";
+                ++failures;
+            }
+        });
+    }
+
+    while (pool.getNumJobs() > 0)
+        juce::Thread::sleep (20);
+
+    std::cout << opts.inputs.size() << " file(s) in "
+              << juce::String ((juce::Time::getMillisecondCounterHiRes() - start) * 0.001, 2)
+              << " s, " << failures.load() << " failed\n";
+
+    return failures.load() == 0 ? 0 : 1;
+}